@@ -3194,6 +3194,17 @@ declare global {
          * The number of bytes sent for each category.
          */
         readonly bytesSent: number[];
+
+        /**
+         * The number of updates in which packets were waiting to be sent.
+         * The total bytes sent divided by this is the average size of a flush.
+         */
+        readonly sendFlushes: number;
+
+        /**
+         * The number of system calls made to send the packets.
+         */
+        readonly sendSyscalls: number;
     }
 
     type PermissionType =
@@ -200,6 +200,8 @@ namespace OpenRCT2
             GfxUnloadG1();
             Audio::Close();
 
+            Profiling::StopTrace();
+
             Instance = nullptr;
         }
 
@@ -1103,8 +1105,15 @@ namespace OpenRCT2
 
             if (_ticksAccumulator < GAME_UPDATE_TIME_MS)
             {
+                // Round up, sleeping for 0 ms would spin until the next tick is due.
                 const auto sleepTimeSec = (GAME_UPDATE_TIME_MS - _ticksAccumulator);
-                Platform::Sleep(static_cast<uint32_t>(sleepTimeSec * 1000.f));
+                const auto sleepTimeMs = static_cast<uint32_t>(std::ceil(sleepTimeSec * 1000.f));
+
+                // Servers wake up as soon as a client sends something, so it is handled before the next tick.
+                if (!NetworkWaitForEvents(sleepTimeMs))
+                {
+                    Platform::Sleep(sleepTimeMs);
+                }
                 return;
             }
 
@@ -249,6 +249,11 @@ namespace OpenRCT2
 
             auto exporter = std::make_unique<ParkFileExporter>();
             exporter->ExportObjectsList = objects;
+            if (gConfigGeneral.FastSaveCompression)
+            {
+                exporter->Compression = OrcaStream::COMPRESSION_ZSTD_CHUNKED;
+                exporter->CompressionLevel = ZstdLevelFast;
+            }
             exporter->Export(replayData->parkData);
 
             replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
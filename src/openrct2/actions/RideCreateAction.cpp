@@ -319,6 +319,7 @@ GameActions::Result RideCreateAction::Execute() const
     ride->MinCarsPerTrain = rideEntry->min_cars_in_train;
     ride->MaxCarsPerTrain = rideEntry->max_cars_in_train;
     RideSetVehicleColoursToRandomPreset(*ride, _colour2);
+    OpenRCT2::Park::OnRideChanged(*ride);
     WindowInvalidateByClass(WindowClass::RideList);
 
     res.Expenditure = ExpenditureType::RideConstruction;
@@ -9,6 +9,8 @@
 
 #include "RideFreezeRatingAction.h"
 
+#include "../world/Park.h"
+
 RideFreezeRatingAction::RideFreezeRatingAction(RideId rideIndex, RideRatingType type, ride_rating value)
     : _rideIndex(rideIndex)
     , _type(type)
@@ -63,6 +65,7 @@ GameActions::Result RideFreezeRatingAction::Execute() const
             ride->nausea = _value;
             break;
     }
+    OpenRCT2::Park::OnRideChanged(*ride);
 
     ride->lifecycle_flags |= RIDE_LIFECYCLE_FIXED_RATINGS;
 
@@ -13,6 +13,7 @@
 #include "../object/ObjectManager.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../world/Park.h"
 
 RideSetSettingAction::RideSetSettingAction(RideId rideIndex, RideSetSetting setting, uint8_t value)
     : _rideIndex(rideIndex)
@@ -226,6 +227,7 @@ GameActions::Result RideSetSettingAction::Execute() const
         case RideSetSetting::RideType:
             ride->type = _value;
             ride->UpdateRideTypeForAllPieces();
+            OpenRCT2::Park::OnRideChanged(*ride);
             GfxInvalidateScreen();
             break;
     }
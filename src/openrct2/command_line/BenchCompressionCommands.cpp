@@ -0,0 +1,163 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../OpenRCT2.h"
+#include "../core/Console.hpp"
+#include "../core/MemoryStream.h"
+#include "../core/OrcaStream.hpp"
+#include "../core/Path.hpp"
+#include "../core/Timer.hpp"
+#include "../park/ParkFile.h"
+#include "../util/Util.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleBenchCompression(CommandLineArgEnumerator* argEnumerator);
+
+static int32_t _benchCompressionIterations = 10;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition BenchCompressionOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_benchCompressionIterations, NAC, "iterations", "times each park is saved and read (default 10)" },
+    OptionTableEnd
+};
+
+const CommandLineCommand CommandLine::BenchCompressionCommands[]
+{
+    // Main commands
+    DefineCommand("", "<file> [<file> ...]", BenchCompressionOptions, HandleBenchCompression),
+    CommandTableEnd
+};
+// clang-format on
+
+struct BenchCodec
+{
+    const char* Name;
+    uint32_t Compression;
+    int32_t Level;
+};
+
+struct CodecBenchResults
+{
+    size_t Size{};
+    double SaveTime{};
+    double ReadTime{};
+};
+
+static CodecBenchResults BenchCodecOnPark(const BenchCodec& codec, int32_t iterations)
+{
+    CodecBenchResults results;
+    Timer timer;
+    for (int32_t i = 0; i < iterations; i++)
+    {
+        MemoryStream ms;
+        timer.Restart();
+        ParkFileExporter exporter;
+        exporter.Compression = codec.Compression;
+        exporter.CompressionLevel = codec.Level;
+        exporter.Export(ms);
+        results.SaveTime += timer.GetElapsedTime().count();
+        results.Size = ms.GetLength();
+
+        // Chunks are decompressed as they are read, so read all of them.
+        ms.SetPosition(0);
+        timer.Restart();
+        OrcaStream os(ms, OrcaStream::Mode::READING);
+        for (auto id : os.GetChunkIds())
+        {
+            os.ReadWriteChunk(id, [](OrcaStream::ChunkStream&) {});
+        }
+        results.ReadTime += timer.GetElapsedTime().count();
+    }
+    results.SaveTime /= iterations;
+    results.ReadTime /= iterations;
+    return results;
+}
+
+/**
+ * Saves parks to memory with each compression mode and level that park files support and reports the size and the
+ * time spent saving and reading them, so codecs can be compared on real parks.
+ */
+static exitcode_t HandleBenchCompression(CommandLineArgEnumerator* argEnumerator)
+{
+    std::vector<u8string> parkPaths;
+
+    const utf8* argument;
+    while (argEnumerator->TryPopString(&argument))
+    {
+        // Options are always passed at the end of the command line.
+        if (argument[0] == '-')
+            break;
+        parkPaths.push_back(Path::GetAbsolute(argument));
+    }
+
+    if (parkPaths.empty())
+    {
+        Console::Error::WriteLine("Missing arguments <file> [<file> ...].");
+        return EXITCODE_FAIL;
+    }
+    const auto iterations = std::max<int32_t>(_benchCompressionIterations, 1);
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    const BenchCodec codecs[] = {
+        { "none", OrcaStream::COMPRESSION_NONE, GzipLevelDefault },
+        { "gzip", OrcaStream::COMPRESSION_GZIP, GzipLevelDefault },
+        { "gzip fast", OrcaStream::COMPRESSION_GZIP, GzipLevelFast },
+        { "chunked", OrcaStream::COMPRESSION_GZIP_CHUNKED, GzipLevelDefault },
+        { "chunked fast", OrcaStream::COMPRESSION_GZIP_CHUNKED, GzipLevelFast },
+        { "zstd", OrcaStream::COMPRESSION_ZSTD_CHUNKED, ZstdLevelDefault },
+        { "zstd fast", OrcaStream::COMPRESSION_ZSTD_CHUNKED, ZstdLevelFast },
+    };
+
+    for (const auto& parkPath : parkPaths)
+    {
+        if (!context->LoadParkFromFile(parkPath))
+        {
+            Console::Error::WriteLine("Unable to load park: %s", parkPath.c_str());
+            return EXITCODE_FAIL;
+        }
+
+        Console::WriteLine("%s", parkPath.c_str());
+        try
+        {
+            // Saving without compression is the cost of serialising the park, the rest is the codec.
+            const auto uncompressed = BenchCodecOnPark(codecs[0], iterations);
+            for (const auto& codec : codecs)
+            {
+                const auto results = &codec == &codecs[0] ? uncompressed : BenchCodecOnPark(codec, iterations);
+                Console::WriteLine(
+                    "  %-12s  %9zu bytes (%5.1f%%)  save: %8.3f ms (codec %8.3f ms)  read: %8.3f ms", codec.Name,
+                    results.Size, results.Size * 100.0 / uncompressed.Size, results.SaveTime * 1000.0,
+                    (results.SaveTime - uncompressed.SaveTime) * 1000.0, results.ReadTime * 1000.0);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to save park: %s", e.what());
+            return EXITCODE_FAIL;
+        }
+    }
+    return EXITCODE_OK;
+}
@@ -0,0 +1,123 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../core/Console.hpp"
+#include "../core/Timer.hpp"
+#include "../entity/EntityList.h"
+#include "../entity/EntityRegistry.h"
+#include "../entity/Litter.h"
+#include "../ride/Vehicle.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleBenchEntities(CommandLineArgEnumerator* argEnumerator);
+
+static int32_t _benchEntityCount = 50000;
+static int32_t _benchEntityOperations = 200000;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition BenchEntitiesOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_benchEntityCount,      NAC, "entities",   "number of live entities (default 50000)"                  },
+    { CMDLINE_TYPE_INTEGER, &_benchEntityOperations, NAC, "operations", "number of entities to remove and create (default 200000)" },
+    OptionTableEnd
+};
+
+const CommandLineCommand CommandLine::BenchEntitiesCommands[]
+{
+    // Main commands
+    DefineCommand("", "", BenchEntitiesOptions, HandleBenchEntities),
+    CommandTableEnd
+};
+// clang-format on
+
+static constexpr int32_t BenchMapSize = 256;
+
+static EntityBase* CreateBenchEntity(std::mt19937& rng, EntityType type)
+{
+    auto* entity = CreateEntity(type);
+    if (entity == nullptr)
+        return nullptr;
+
+    // Spread the entities over the map so the spatial index buckets stay small, as they would in a park.
+    std::uniform_int_distribution<int32_t> tileDist(1, BenchMapSize - 2);
+    entity->MoveTo({ tileDist(rng) * COORDS_XY_STEP + 16, tileDist(rng) * COORDS_XY_STEP + 16, 0 });
+    return entity;
+}
+
+template<typename T> static int64_t SumEntityPositions()
+{
+    int64_t sum = 0;
+    for (auto* entity : EntityList<T>())
+    {
+        sum += entity->x;
+    }
+    return sum;
+}
+
+/**
+ * Measures the cost of creating and removing entities when the entity lists are nearly full, as happens when litter,
+ * balloons and money effects come and go in a busy park. Entities are removed at random so the freed ids are spread
+ * over the whole id range.
+ */
+static exitcode_t HandleBenchEntities(CommandLineArgEnumerator* argEnumerator)
+{
+    const auto numEntities = std::clamp<int32_t>(_benchEntityCount, 1, MAX_ENTITIES - 1);
+    const auto numOperations = std::max<int32_t>(_benchEntityOperations, 1);
+
+    ResetAllEntities();
+
+    // Fixed seed, every run performs the same sequence of operations.
+    std::mt19937 rng(0x4f52);
+    std::vector<EntityBase*> entities;
+    entities.reserve(numEntities);
+
+    Timer timer;
+    for (int32_t i = 0; i < numEntities; i++)
+    {
+        const auto type = (i % 4) == 0 ? EntityType::Vehicle : EntityType::Litter;
+        entities.push_back(CreateBenchEntity(rng, type));
+    }
+    const auto populateTime = timer.GetElapsedTimeAndRestart().count();
+
+    std::uniform_int_distribution<size_t> entityDist(0, entities.size() - 1);
+    for (int32_t i = 0; i < numOperations; i++)
+    {
+        auto& entity = entities[entityDist(rng)];
+        const auto type = entity->Type;
+        EntityRemove(entity);
+        entity = CreateBenchEntity(rng, type);
+    }
+    const auto churnTime = timer.GetElapsedTimeAndRestart().count();
+
+    constexpr int32_t iterationPasses = 100;
+    int64_t checksum = 0;
+    for (int32_t i = 0; i < iterationPasses; i++)
+    {
+        checksum += SumEntityPositions<Litter>() + SumEntityPositions<Vehicle>();
+    }
+    const auto iterateTime = timer.GetElapsedTime().count();
+
+    Console::WriteLine("Entities:   %d live, %d free", numEntities, GetNumFreeEntities());
+    Console::WriteLine(
+        "Populate:   %.3f ms total, %.1f ns per entity", populateTime * 1000.0f, populateTime * 1e9 / numEntities);
+    Console::WriteLine(
+        "Churn:      %.3f ms total, %.1f ns per remove and create", churnTime * 1000.0f, churnTime * 1e9 / numOperations);
+    Console::WriteLine(
+        "Iterate:    %.3f ms total, %.1f ns per entity (checksum %lld)", iterateTime * 1000.0f,
+        iterateTime * 1e9 / (static_cast<double>(numEntities) * iterationPasses), static_cast<long long>(checksum));
+
+    ResetAllEntities();
+    return EXITCODE_OK;
+}
@@ -0,0 +1,193 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../Game.h"
+#include "../OpenRCT2.h"
+#include "../core/Console.hpp"
+#include "../core/Path.hpp"
+#include "../core/Timer.hpp"
+#include "../drawing/NewDrawing.h"
+#include "../drawing/X8DrawingEngine.h"
+#include "../interface/Viewport.h"
+#include "../interface/Window.h"
+#include "../paint/Paint.h"
+#include "../paint/PaintCapture.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Drawing;
+
+static exitcode_t HandleBenchPaint(CommandLineArgEnumerator* argEnumerator);
+
+static int32_t _benchPaintIterations = 100;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition BenchPaintOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_benchPaintIterations, NAC, "iterations", "times each capture is painted (default 100)" },
+    OptionTableEnd
+};
+
+const CommandLineCommand CommandLine::BenchPaintCommands[]
+{
+    // Main commands
+    DefineCommand("", "<capture> [<capture> ...]", BenchPaintOptions, HandleBenchPaint),
+    CommandTableEnd
+};
+// clang-format on
+
+struct PaintBenchResults
+{
+    size_t Columns{};
+    size_t PaintEntries{};
+    double GenerateTime{};
+    double ArrangeTime{};
+    double DrawTime{};
+};
+
+/**
+ * Paints the view of a capture one column after the other, the same way ViewportPaint does without multithreading,
+ * and times each phase separately.
+ */
+static void BenchPaintView(const Viewport& viewport, X8DrawingEngine& drawingEngine, PaintBenchResults& results)
+{
+    const auto& screenDPI = *drawingEngine.GetDrawingPixelInfo();
+
+    DrawPixelInfo dpi{};
+    dpi.DrawingEngine = &drawingEngine;
+    dpi.bits = screenDPI.bits;
+    dpi.x = viewport.viewPos.x;
+    dpi.y = viewport.viewPos.y;
+    dpi.width = viewport.view_width;
+    dpi.height = viewport.view_height;
+    dpi.pitch = (screenDPI.width + screenDPI.pitch) - viewport.zoom.ApplyInversedTo(viewport.view_width);
+    dpi.zoom_level = viewport.zoom;
+
+    Timer timer;
+    for (auto x = Floor2(dpi.x, 32); x < dpi.x + dpi.width; x += 32)
+    {
+        auto* session = PaintSessionAlloc(dpi, viewport.flags);
+        ViewportClipToColumn(session->DPI, x);
+
+        timer.Restart();
+        PaintSessionGenerate(*session);
+        results.GenerateTime += timer.GetElapsedTimeAndRestart().count();
+
+        PaintSessionArrange(*session);
+        results.ArrangeTime += timer.GetElapsedTimeAndRestart().count();
+
+        PaintDrawStructs(*session);
+        if (session->PSStringHead != nullptr)
+        {
+            PaintDrawMoneyStructs(session->DPI, session->PSStringHead);
+        }
+        results.DrawTime += timer.GetElapsedTime().count();
+
+        results.Columns++;
+        results.PaintEntries += session->PaintEntryChain.GetCount();
+        PaintSessionFree(session);
+    }
+}
+
+/**
+ * Replays paint captures made with the paint_capture console command on the software drawing engine, without a
+ * window, and reports the time spent generating, sorting and drawing the paint structs of each capture.
+ */
+static exitcode_t HandleBenchPaint(CommandLineArgEnumerator* argEnumerator)
+{
+    std::vector<u8string> capturePaths;
+
+    const utf8* argument;
+    while (argEnumerator->TryPopString(&argument))
+    {
+        // Options are always passed at the end of the command line.
+        if (argument[0] == '-')
+            break;
+        capturePaths.push_back(Path::GetAbsolute(argument));
+    }
+
+    if (capturePaths.empty())
+    {
+        Console::Error::WriteLine("Missing arguments <capture> [<capture> ...].");
+        return EXITCODE_FAIL;
+    }
+    const auto iterations = std::max<int32_t>(_benchPaintIterations, 1);
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    DrawingEngineInit();
+    auto drawingEngine = std::make_unique<X8DrawingEngine>(context->GetUiContext());
+
+    auto exitCode = EXITCODE_OK;
+    for (const auto& capturePath : capturePaths)
+    {
+        PaintCapture capture;
+        try
+        {
+            capture = PaintCaptureLoad(capturePath);
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to load paint capture %s: %s", capturePath.c_str(), e.what());
+            exitCode = EXITCODE_FAIL;
+            break;
+        }
+
+        if (!context->LoadParkFromFile(capture.ParkPath))
+        {
+            Console::Error::WriteLine("Unable to load park: %s", capture.ParkPath.c_str());
+            exitCode = EXITCODE_FAIL;
+            break;
+        }
+
+        // Ensure sprites appear regardless of rotation.
+        ResetAllSpriteQuadrantPlacements();
+        gCurrentRotation = capture.Rotation;
+
+        const auto viewport = PaintCaptureGetViewport(capture);
+        drawingEngine->Resize(capture.Width, capture.Height);
+
+        PaintBenchResults results;
+        for (int32_t i = 0; i < iterations; i++)
+        {
+            BenchPaintView(viewport, *drawingEngine, results);
+        }
+
+        const auto generateMs = results.GenerateTime * 1000.0 / iterations;
+        const auto arrangeMs = results.ArrangeTime * 1000.0 / iterations;
+        const auto drawMs = results.DrawTime * 1000.0 / iterations;
+        Console::WriteLine("%s", capturePath.c_str());
+        Console::WriteLine(
+            "  View:          %dx%d at zoom %d, rotation %d", capture.Width, capture.Height, static_cast<int8_t>(capture.Zoom),
+            capture.Rotation);
+        Console::WriteLine(
+            "  Paint entries: %zu in %zu columns", results.PaintEntries / iterations, results.Columns / iterations);
+        Console::WriteLine("  Generate:      %.3f ms", generateMs);
+        Console::WriteLine("  Arrange:       %.3f ms", arrangeMs);
+        Console::WriteLine("  Draw:          %.3f ms", drawMs);
+        Console::WriteLine("  Total:         %.3f ms", generateMs + arrangeMs + drawMs);
+    }
+
+    drawingEngine.reset();
+    DrawingEngineDispose();
+    return exitCode;
+}
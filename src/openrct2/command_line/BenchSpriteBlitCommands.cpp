@@ -0,0 +1,156 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../core/Console.hpp"
+#include "../core/Timer.hpp"
+#include "../drawing/Drawing.h"
+#include "../util/Util.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleBenchSpriteBlit(CommandLineArgEnumerator* argEnumerator);
+
+static int32_t _benchBlitIterations = 200;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition BenchSpriteBlitOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_benchBlitIterations, NAC, "iterations", "number of passes over the runs (default 200)" },
+    OptionTableEnd
+};
+
+const CommandLineCommand CommandLine::BenchSpriteBlitCommands[]
+{
+    // Main commands
+    DefineCommand("", "", BenchSpriteBlitOptions, HandleBenchSpriteBlit),
+    CommandTableEnd
+};
+// clang-format on
+
+// RLE runs are at most 127 pixels long, most sprite runs are a few dozen pixels.
+static constexpr int32_t BenchMaxRunLength = 127;
+static constexpr int32_t BenchNumRuns = 4096;
+
+struct BenchRun
+{
+    size_t Offset;
+    int32_t Length;
+};
+
+struct BenchRunFunction
+{
+    const char* Name;
+    bool Available;
+    RLERunFunc RemapSrc;
+    RLERunFunc RemapDst;
+};
+
+static double TimeRunFunction(
+    RLERunFunc func, const std::vector<BenchRun>& runs, const std::vector<uint8_t>& src, const std::vector<uint8_t>& dst,
+    std::vector<uint8_t>& output, const uint8_t* paletteTable, int32_t iterations)
+{
+    Timer timer;
+    for (int32_t i = 0; i < iterations; i++)
+    {
+        // Start from the same destination every pass, the remap of the destination would otherwise compound.
+        std::copy(dst.begin(), dst.end(), output.begin());
+        for (const auto& run : runs)
+        {
+            func(src.data() + run.Offset, output.data() + run.Offset, paletteTable, run.Length);
+        }
+    }
+    return timer.GetElapsedTime().count();
+}
+
+/**
+ * Measures the RLE sprite run functions for every instruction set the CPU supports on random runs, and checks that
+ * they all produce the same pixels as the scalar functions.
+ */
+static exitcode_t HandleBenchSpriteBlit(CommandLineArgEnumerator* argEnumerator)
+{
+    const auto iterations = std::max<int32_t>(_benchBlitIterations, 1);
+
+    // Fixed seed, every run blits the same pixels.
+    std::mt19937 rng(0x424c4954);
+    std::uniform_int_distribution<int32_t> byteDist(0, 255);
+    std::uniform_int_distribution<int32_t> lengthDist(1, BenchMaxRunLength);
+
+    std::array<uint8_t, 256> paletteTable{};
+    for (size_t i = 0; i < paletteTable.size(); i++)
+    {
+        paletteTable[i] = static_cast<uint8_t>(byteDist(rng));
+    }
+
+    std::vector<BenchRun> runs;
+    size_t numPixels = 0;
+    for (int32_t i = 0; i < BenchNumRuns; i++)
+    {
+        const auto length = lengthDist(rng);
+        runs.push_back({ numPixels, length });
+        numPixels += length;
+    }
+    std::vector<uint8_t> src(numPixels);
+    std::vector<uint8_t> dst(numPixels);
+    for (size_t i = 0; i < numPixels; i++)
+    {
+        src[i] = (byteDist(rng) % 8) == 0 ? 0 : static_cast<uint8_t>(byteDist(rng));
+        dst[i] = static_cast<uint8_t>(byteDist(rng));
+    }
+
+    const BenchRunFunction functions[] = {
+        { "scalar", true, RLERemapSrcRunScalar, RLERemapDstRunScalar },
+        { "SSE4.1", SSE41Available(), RLERemapSrcRunSse4_1, RLERemapDstRunSse4_1 },
+        { "AVX2", AVX2Available(), RLERemapSrcRunAvx2, RLERemapDstRunAvx2 },
+    };
+
+    std::vector<uint8_t> expectedSrc(numPixels);
+    std::vector<uint8_t> expectedDst(numPixels);
+    std::vector<uint8_t> output(numPixels);
+    bool allMatch = true;
+
+    const auto totalPixels = static_cast<double>(numPixels) * iterations;
+    Console::WriteLine("Runs:       %d, %zu pixels, %d iterations", BenchNumRuns, numPixels, iterations);
+    for (const auto& function : functions)
+    {
+        if (!function.Available)
+        {
+            Console::WriteLine("%-10s  not supported by this CPU", function.Name);
+            continue;
+        }
+
+        const auto srcTime = TimeRunFunction(function.RemapSrc, runs, src, dst, output, paletteTable.data(), iterations);
+        const auto srcMatches = function.RemapSrc == RLERemapSrcRunScalar || output == expectedSrc;
+        if (function.RemapSrc == RLERemapSrcRunScalar)
+            expectedSrc = output;
+
+        const auto dstTime = TimeRunFunction(function.RemapDst, runs, src, dst, output, paletteTable.data(), iterations);
+        const auto dstMatches = function.RemapDst == RLERemapDstRunScalar || output == expectedDst;
+        if (function.RemapDst == RLERemapDstRunScalar)
+            expectedDst = output;
+
+        allMatch = allMatch && srcMatches && dstMatches;
+        Console::WriteLine(
+            "%-10s  remap source: %.3f ms, %.2f ns per pixel%s  remap destination: %.3f ms, %.2f ns per pixel%s",
+            function.Name, srcTime * 1000.0, srcTime * 1e9 / totalPixels, srcMatches ? "" : " (MISMATCH)",
+            dstTime * 1000.0, dstTime * 1e9 / totalPixels, dstMatches ? "" : " (MISMATCH)");
+    }
+
+    if (!allMatch)
+    {
+        Console::Error::WriteLine("Run functions do not produce the same pixels as the scalar functions.");
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
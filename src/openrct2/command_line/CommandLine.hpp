@@ -117,6 +117,11 @@ namespace CommandLine
     extern const CommandLineCommand ScreenshotCommands[];
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand SimulateCommands[];
+    extern const CommandLineCommand BenchSimulateCommands[];
+    extern const CommandLineCommand BenchEntitiesCommands[];
+    extern const CommandLineCommand BenchPaintCommands[];
+    extern const CommandLineCommand BenchSpriteBlitCommands[];
+    extern const CommandLineCommand BenchCompressionCommands[];
     extern const CommandLineCommand ParkInfoCommands[];
 
     extern const CommandLineExample RootExamples[];
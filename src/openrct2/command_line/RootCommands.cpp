@@ -24,6 +24,7 @@
 #include "../park/ParkFile.h"
 #include "../platform/Crash.h"
 #include "../platform/Platform.h"
+#include "../profiling/Profiling.h"
 #include "../scripting/ScriptEngine.h"
 #include "CommandLine.hpp"
 
@@ -60,6 +61,7 @@ static u8string _openrct2DataPath = {};
 static u8string _rct1DataPath = {};
 static u8string _rct2DataPath = {};
 static bool _silentBreakpad = false;
+static u8string _tracePath = {};
 
 // clang-format off
 static constexpr CommandLineOptionDefinition StandardOptions[]
@@ -80,6 +82,7 @@ static constexpr CommandLineOptionDefinition StandardOptions[]
     { CMDLINE_TYPE_STRING,  &_openrct2DataPath, NAC, "openrct2-data-path", "path to the OpenRCT2 data directory (containing languages)" },
     { CMDLINE_TYPE_STRING,  &_rct1DataPath,     NAC, "rct1-data-path",     "path to the RollerCoaster Tycoon 1 data directory (containing data/csg1.dat)" },
     { CMDLINE_TYPE_STRING,  &_rct2DataPath,     NAC, "rct2-data-path",     "path to the RollerCoaster Tycoon 2 data directory (containing data/g1.dat)" },
+    { CMDLINE_TYPE_STRING,  &_tracePath,        NAC, "profiler-trace",     "write a Chrome trace of all profiled functions to the given file" },
 #ifdef USE_BREAKPAD
     { CMDLINE_TYPE_SWITCH,  &_silentBreakpad,  NAC, "silent-breakpad",   "make breakpad crash reporting silent"                       },
 #endif // USE_BREAKPAD
@@ -141,6 +144,11 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("screenshot",      CommandLine::ScreenshotCommands       ),
     DefineSubCommand("sprite",          CommandLine::SpriteCommands           ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
+    DefineSubCommand("benchsimulate",   CommandLine::BenchSimulateCommands    ),
+    DefineSubCommand("benchentities",   CommandLine::BenchEntitiesCommands    ),
+    DefineSubCommand("benchpaint",      CommandLine::BenchPaintCommands       ),
+    DefineSubCommand("benchspriteblit", CommandLine::BenchSpriteBlitCommands  ),
+    DefineSubCommand("benchcompression", CommandLine::BenchCompressionCommands),
     DefineSubCommand("parkinfo",        CommandLine::ParkInfoCommands         ),
     CommandTableEnd
 };
@@ -222,6 +230,16 @@ exitcode_t CommandLine::HandleCommandDefault()
         gCustomPassword = _password;
     }
 
+    if (result == EXITCODE_CONTINUE && !_tracePath.empty())
+    {
+        auto tracePath = Path::GetAbsolute(_tracePath);
+        if (!OpenRCT2::Profiling::StartTrace(tracePath))
+        {
+            Console::Error::WriteLine("Unable to open profiler trace file: %s", tracePath.c_str());
+            return EXITCODE_FAIL;
+        }
+    }
+
     return result;
 }
 
@@ -11,23 +11,55 @@
 #include "../Game.h"
 #include "../GameState.h"
 #include "../OpenRCT2.h"
+#include "../Version.h"
 #include "../core/Console.hpp"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../core/Timer.hpp"
 #include "../entity/EntityRegistry.h"
 #include "../network/network.h"
 #include "../platform/Platform.h"
+#include "../profiling/Profiling.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchSimulate(CommandLineArgEnumerator* argEnumerator);
+
+static int32_t _benchWarmupTicks = 100;
+static int32_t _benchTicks = 1000;
+static u8string _benchOutputPath;
 
 const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
                                                           DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
 };
 
+// clang-format off
+static constexpr CommandLineOptionDefinition BenchSimulateOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_benchWarmupTicks, NAC, "warmup", "number of ticks to run before measuring (default 100)" },
+    { CMDLINE_TYPE_INTEGER, &_benchTicks,       NAC, "ticks",  "number of ticks to measure (default 1000)"             },
+    { CMDLINE_TYPE_STRING,  &_benchOutputPath,  'o', "output", "write the JSON report to a file instead of stdout"     },
+    OptionTableEnd
+};
+
+const CommandLineCommand CommandLine::BenchSimulateCommands[]
+{
+    // Main commands
+    DefineCommand("", "<file> [<file> ...]", BenchSimulateOptions, HandleBenchSimulate),
+    CommandTableEnd
+};
+// clang-format on
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
     const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
@@ -71,3 +103,200 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 
     return EXITCODE_OK;
 }
+
+/**
+ * Returns the value at the given percentile (0-100) of a sorted list of samples using the nearest-rank method.
+ */
+static double GetPercentile(const std::vector<double>& sortedSamples, double percentile)
+{
+    if (sortedSamples.empty())
+        return 0.0;
+
+    auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sortedSamples.size()));
+    rank = std::clamp<size_t>(rank, 1, sortedSamples.size());
+    return sortedSamples[rank - 1];
+}
+
+static Profiling::Function* FindProfiledFunction(std::string_view name)
+{
+    for (auto* func : Profiling::GetData())
+    {
+        if (std::string_view(func->GetName()).find(name) != std::string_view::npos)
+        {
+            return func;
+        }
+    }
+    return nullptr;
+}
+
+static json_t BenchSimulatePark(IContext& context, const u8string& path, uint32_t warmupTicks, uint32_t ticks)
+{
+    auto* gameState = context.GetGameState();
+
+    for (uint32_t i = 0; i < warmupTicks; i++)
+    {
+        gameState->UpdateLogic();
+    }
+
+    // Measure tick latency without the profiler, the overhead of the nested profiled functions
+    // (per-peep pathfinding, actions etc.) would otherwise skew the results.
+    const bool profilerWasEnabled = Profiling::IsEnabled();
+    Profiling::Disable();
+
+    std::vector<double> tickTimesUs;
+    tickTimesUs.reserve(ticks);
+
+    Timer timer;
+    for (uint32_t i = 0; i < ticks; i++)
+    {
+        timer.Restart();
+        gameState->UpdateLogic();
+        tickTimesUs.push_back(std::chrono::duration<double, std::micro>(timer.GetElapsedTime()).count());
+    }
+
+    // Run the same amount of ticks again with the profiler enabled to split the time across the
+    // subsystems called from UpdateLogic.
+    Profiling::ResetData();
+    Profiling::Enable();
+    for (uint32_t i = 0; i < ticks; i++)
+    {
+        gameState->UpdateLogic();
+    }
+    if (!profilerWasEnabled)
+    {
+        Profiling::Disable();
+    }
+
+    json_t breakdown = json_t::array();
+    auto* updateLogicFunc = FindProfiledFunction("GameState::UpdateLogic");
+    if (updateLogicFunc != nullptr)
+    {
+        const auto updateLogicTotalUs = updateLogicFunc->GetTotalTime();
+
+        auto children = updateLogicFunc->GetChildren();
+        std::sort(children.begin(), children.end(), [](const Profiling::Function* a, const Profiling::Function* b) {
+            return a->GetTotalTime() > b->GetTotalTime();
+        });
+
+        double childrenTotalUs = 0.0;
+        for (const auto* child : children)
+        {
+            const auto totalUs = child->GetTotalTime();
+            childrenTotalUs += totalUs;
+            breakdown.push_back({
+                { "function", child->GetName() },
+                { "calls", child->GetCallCount() },
+                { "totalUs", totalUs },
+                { "meanUsPerTick", ticks != 0 ? totalUs / ticks : 0.0 },
+                { "share", updateLogicTotalUs > 0.0 ? totalUs / updateLogicTotalUs : 0.0 },
+            });
+        }
+
+        // Time spent directly in UpdateLogic or in functions that are not profiled.
+        const auto selfUs = std::max(0.0, updateLogicTotalUs - childrenTotalUs);
+        breakdown.push_back({
+            { "function", "(other)" },
+            { "calls", updateLogicFunc->GetCallCount() },
+            { "totalUs", selfUs },
+            { "meanUsPerTick", ticks != 0 ? selfUs / ticks : 0.0 },
+            { "share", updateLogicTotalUs > 0.0 ? selfUs / updateLogicTotalUs : 0.0 },
+        });
+    }
+
+    double totalUs = 0.0;
+    for (auto sample : tickTimesUs)
+    {
+        totalUs += sample;
+    }
+
+    auto sortedTickTimesUs = tickTimesUs;
+    std::sort(sortedTickTimesUs.begin(), sortedTickTimesUs.end());
+
+    json_t result = {
+        { "path", path },
+        { "warmupTicks", warmupTicks },
+        { "ticks", ticks },
+        { "totalMs", totalUs / 1000.0 },
+        { "ticksPerSecond", totalUs > 0.0 ? ticks / (totalUs / 1000000.0) : 0.0 },
+        { "latencyUs",
+          {
+              { "min", sortedTickTimesUs.empty() ? 0.0 : sortedTickTimesUs.front() },
+              { "mean", ticks != 0 ? totalUs / ticks : 0.0 },
+              { "p50", GetPercentile(sortedTickTimesUs, 50) },
+              { "p95", GetPercentile(sortedTickTimesUs, 95) },
+              { "p99", GetPercentile(sortedTickTimesUs, 99) },
+              { "max", sortedTickTimesUs.empty() ? 0.0 : sortedTickTimesUs.back() },
+          } },
+        { "breakdown", breakdown },
+        { "checksum", GetAllEntitiesChecksum().ToString() },
+    };
+    return result;
+}
+
+static exitcode_t HandleBenchSimulate(CommandLineArgEnumerator* argEnumerator)
+{
+    std::vector<u8string> parkPaths;
+
+    const utf8* argument;
+    while (argEnumerator->TryPopString(&argument))
+    {
+        // Options are always passed at the end of the command line.
+        if (argument[0] == '-')
+            break;
+        parkPaths.push_back(Path::GetAbsolute(argument));
+    }
+
+    if (parkPaths.empty())
+    {
+        Console::Error::WriteLine("Missing arguments <file> [<file> ...].");
+        return EXITCODE_FAIL;
+    }
+    if (_benchWarmupTicks < 0 || _benchTicks <= 0)
+    {
+        Console::Error::WriteLine("Invalid number of ticks.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    json_t parks = json_t::array();
+    for (const auto& parkPath : parkPaths)
+    {
+        if (!context->LoadParkFromFile(parkPath))
+        {
+            Console::Error::WriteLine("Unable to load park: %s", parkPath.c_str());
+            return EXITCODE_FAIL;
+        }
+
+        Console::Error::WriteLine(
+            "Benchmarking %s (%d warmup ticks, %d ticks)...", parkPath.c_str(), _benchWarmupTicks, _benchTicks);
+        parks.push_back(BenchSimulatePark(
+            *context, parkPath, static_cast<uint32_t>(_benchWarmupTicks), static_cast<uint32_t>(_benchTicks)));
+    }
+
+    json_t report = {
+        { "version", std::string(gVersionInfoFull) },
+        { "platform", OPENRCT2_PLATFORM },
+        { "architecture", OPENRCT2_ARCHITECTURE },
+        { "parks", parks },
+    };
+
+    if (_benchOutputPath.empty())
+    {
+        Console::Write(report.dump(4).c_str());
+        Console::WriteLine();
+    }
+    else
+    {
+        Json::WriteToFile(_benchOutputPath, report);
+    }
+
+    return EXITCODE_OK;
+}
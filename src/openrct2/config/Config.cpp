@@ -147,6 +147,8 @@ namespace Config
             model->AlwaysShowGridlines = reader->GetBoolean("always_show_gridlines", false);
             model->AutosaveFrequency = reader->GetInt32("autosave", AUTOSAVE_EVERY_5MINUTES);
             model->AutosaveAmount = reader->GetInt32("autosave_amount", DEFAULT_NUM_AUTOSAVES_TO_KEEP);
+            model->FastSaveCompression = reader->GetBoolean("fast_save_compression", false);
+            model->ParallelSaveCompression = reader->GetBoolean("parallel_save_compression", false);
             model->ConfirmationPrompt = reader->GetBoolean("confirmation_prompt", false);
             model->CurrencyFormat = reader->GetEnum<CurrencyType>(
                 "currency_format", Platform::GetLocaleCurrency(), Enum_Currency);
@@ -228,6 +230,7 @@ namespace Config
             model->EnabledAssetPacks = reader->GetString("enabled_asset_packs", "");
             model->TransparentScreenshot = reader->GetBoolean("transparent_screenshot", true);
             model->TransparentWater = reader->GetBoolean("transparent_water", true);
+            model->SpriteCacheSize = reader->GetInt32("sprite_cache_size", 32);
 
             model->InvisibleRides = reader->GetBoolean("invisible_rides", false);
             model->InvisibleVehicles = reader->GetBoolean("invisible_vehicles", false);
@@ -247,6 +250,8 @@ namespace Config
         writer->WriteBoolean("always_show_gridlines", model->AlwaysShowGridlines);
         writer->WriteInt32("autosave", model->AutosaveFrequency);
         writer->WriteInt32("autosave_amount", model->AutosaveAmount);
+        writer->WriteBoolean("fast_save_compression", model->FastSaveCompression);
+        writer->WriteBoolean("parallel_save_compression", model->ParallelSaveCompression);
         writer->WriteBoolean("confirmation_prompt", model->ConfirmationPrompt);
         writer->WriteEnum<CurrencyType>("currency_format", model->CurrencyFormat, Enum_Currency);
         writer->WriteInt32("custom_currency_rate", model->CustomCurrencyRate);
@@ -314,6 +319,7 @@ namespace Config
         writer->WriteEnum<VirtualFloorStyles>("virtual_floor_style", model->VirtualFloorStyle, Enum_VirtualFloorStyle);
         writer->WriteBoolean("transparent_screenshot", model->TransparentScreenshot);
         writer->WriteBoolean("transparent_water", model->TransparentWater);
+        writer->WriteInt32("sprite_cache_size", model->SpriteCacheSize);
         writer->WriteBoolean("invisible_rides", model->InvisibleRides);
         writer->WriteBoolean("invisible_vehicles", model->InvisibleVehicles);
         writer->WriteBoolean("invisible_trees", model->InvisibleTrees);
@@ -60,6 +60,7 @@ struct GeneralConfiguration
     bool ShowGuestPurchases;
     bool TransparentScreenshot;
     bool TransparentWater;
+    int32_t SpriteCacheSize;
 
     bool InvisibleRides;
     bool InvisibleVehicles;
@@ -93,6 +94,8 @@ struct GeneralConfiguration
     bool DebuggingTools;
     int32_t AutosaveFrequency;
     int32_t AutosaveAmount;
+    bool FastSaveCompression;
+    bool ParallelSaveCompression;
     bool AutoStaffPlacement;
     bool HandymenMowByDefault;
     bool AutoOpenShops;
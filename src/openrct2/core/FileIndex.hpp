@@ -199,7 +199,6 @@ private:
         const size_t totalCount = scanResult.Files.size();
         if (totalCount > 0)
         {
-            JobPool jobPool;
             std::mutex printLock; // For verbose prints.
 
             std::list<std::vector<TItem>> containers;
@@ -213,6 +212,8 @@ private:
                 Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
             };
 
+            // Declared after everything its tasks use, so it waits for them before those are destroyed.
+            JobPool::TaskGroup taskGroup(JobPool::GetShared());
             for (size_t rangeStart = 0; rangeStart < totalCount; rangeStart += stepSize)
             {
                 if (rangeStart + stepSize > totalCount)
@@ -222,14 +223,16 @@ private:
 
                 auto& items = containers.emplace_back();
 
-                jobPool.AddTask([&, rangeStart, stepSize]() {
+                taskGroup.Run([&, rangeStart, stepSize]() {
                     BuildRange(language, scanResult, rangeStart, rangeStart + stepSize, items, processed, printLock);
-                });
 
-                reportProgress();
+                    std::lock_guard<std::mutex> lock(printLock);
+                    reportProgress();
+                });
             }
 
-            jobPool.Join(reportProgress);
+            taskGroup.Wait();
+            reportProgress();
 
             for (const auto& itr : containers)
             {
@@ -163,6 +163,45 @@ namespace Imaging
         }
     }
 
+    static png_colorp SetPngPalette(png_structp png_ptr, png_infop info_ptr, const GamePalette& palette)
+    {
+        auto png_palette = static_cast<png_colorp>(png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
+        if (png_palette == nullptr)
+        {
+            throw std::runtime_error("png_malloc failed.");
+        }
+        for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
+        {
+            const auto& entry = palette[static_cast<uint16_t>(i)];
+            png_palette[i].blue = entry.Blue;
+            png_palette[i].green = entry.Green;
+            png_palette[i].red = entry.Red;
+        }
+        png_set_PLTE(png_ptr, info_ptr, png_palette, PNG_MAX_PALETTE_LENGTH);
+        return png_palette;
+    }
+
+    static void WritePngHeader(png_structp png_ptr, png_infop info_ptr, uint32_t width, uint32_t height, uint32_t depth)
+    {
+        png_text text_ptr[1];
+        text_ptr[0].key = const_cast<char*>("Software");
+        text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
+        text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
+
+        auto colourType = PNG_COLOR_TYPE_RGB_ALPHA;
+        if (depth == 8)
+        {
+            png_byte transparentIndex = 0;
+            png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
+            colourType = PNG_COLOR_TYPE_PALETTE;
+        }
+        png_set_text(png_ptr, info_ptr, text_ptr, 1);
+        png_set_IHDR(
+            png_ptr, info_ptr, width, height, 8, colourType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+            PNG_FILTER_TYPE_DEFAULT);
+        png_write_info(png_ptr, info_ptr);
+    }
+
     static void WritePng(std::ostream& ostream, const Image& image)
     {
         png_structp png_ptr = nullptr;
@@ -175,11 +214,6 @@ namespace Imaging
                 throw std::runtime_error("png_create_write_struct failed.");
             }
 
-            png_text text_ptr[1];
-            text_ptr[0].key = const_cast<char*>("Software");
-            text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
-            text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
-
             auto info_ptr = png_create_info_struct(png_ptr);
             if (info_ptr == nullptr)
             {
@@ -193,20 +227,7 @@ namespace Imaging
                     throw std::runtime_error("Expected a palette for 8-bit image.");
                 }
 
-                // Set the palette
-                png_palette = static_cast<png_colorp>(png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
-                if (png_palette == nullptr)
-                {
-                    throw std::runtime_error("png_malloc failed.");
-                }
-                for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
-                {
-                    const auto& entry = (*image.Palette)[static_cast<uint16_t>(i)];
-                    png_palette[i].blue = entry.Blue;
-                    png_palette[i].green = entry.Green;
-                    png_palette[i].red = entry.Red;
-                }
-                png_set_PLTE(png_ptr, info_ptr, png_palette, PNG_MAX_PALETTE_LENGTH);
+                png_palette = SetPngPalette(png_ptr, info_ptr, *image.Palette);
             }
 
             png_set_write_fn(png_ptr, &ostream, PngWriteData, PngFlush);
@@ -217,19 +238,7 @@ namespace Imaging
                 throw std::runtime_error("PNG ERROR");
             }
 
-            // Write header
-            auto colourType = PNG_COLOR_TYPE_RGB_ALPHA;
-            if (image.Depth == 8)
-            {
-                png_byte transparentIndex = 0;
-                png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
-                colourType = PNG_COLOR_TYPE_PALETTE;
-            }
-            png_set_text(png_ptr, info_ptr, text_ptr, 1);
-            png_set_IHDR(
-                png_ptr, info_ptr, image.Width, image.Height, 8, colourType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
-                PNG_FILTER_TYPE_DEFAULT);
-            png_write_info(png_ptr, info_ptr);
+            WritePngHeader(png_ptr, info_ptr, image.Width, image.Height, image.Depth);
 
             // Write pixels
             auto pixels = image.Pixels.data();
@@ -252,6 +261,104 @@ namespace Imaging
         }
     }
 
+    struct PngWriter::Impl
+    {
+        std::ofstream Stream;
+        png_structp Png{};
+        png_infop Info{};
+        png_colorp Palette{};
+        uint32_t Height{};
+        uint32_t RowsWritten{};
+
+        ~Impl()
+        {
+            if (Png != nullptr)
+            {
+                png_free(Png, Palette);
+                png_destroy_write_struct(&Png, &Info);
+            }
+        }
+    };
+
+    PngWriter::PngWriter(std::string_view path, uint32_t width, uint32_t height, const GamePalette& palette)
+        : _impl(std::make_unique<Impl>())
+    {
+        _impl->Height = height;
+        _impl->Stream.open(fs::u8path(path), std::ios::binary);
+        if (!_impl->Stream.is_open())
+        {
+            throw std::runtime_error("Unable to open file for writing.");
+        }
+
+        auto png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
+        if (png_ptr == nullptr)
+        {
+            throw std::runtime_error("png_create_write_struct failed.");
+        }
+        _impl->Png = png_ptr;
+
+        _impl->Info = png_create_info_struct(png_ptr);
+        if (_impl->Info == nullptr)
+        {
+            throw std::runtime_error("png_create_info_struct failed.");
+        }
+
+        _impl->Palette = SetPngPalette(png_ptr, _impl->Info, palette);
+        png_set_write_fn(png_ptr, &_impl->Stream, PngWriteData, PngFlush);
+
+        // Set error handler
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        WritePngHeader(png_ptr, _impl->Info, width, height, 8);
+    }
+
+    PngWriter::~PngWriter() = default;
+
+    void PngWriter::WriteRows(const uint8_t* pixels, uint32_t numRows, uint32_t stride)
+    {
+        if (numRows > _impl->Height - _impl->RowsWritten)
+        {
+            throw std::out_of_range("More rows written than the image has.");
+        }
+
+        auto png_ptr = _impl->Png;
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        for (uint32_t y = 0; y < numRows; y++)
+        {
+            png_write_row(png_ptr, const_cast<png_byte*>(pixels));
+            pixels += stride;
+        }
+        _impl->RowsWritten += numRows;
+    }
+
+    void PngWriter::Finish()
+    {
+        if (_impl->RowsWritten != _impl->Height)
+        {
+            throw std::runtime_error("Not all rows of the image have been written.");
+        }
+
+        auto png_ptr = _impl->Png;
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        png_write_end(png_ptr, nullptr);
+        _impl->Stream.flush();
+        if (!_impl->Stream)
+        {
+            throw std::runtime_error("Unable to write file.");
+        }
+    }
+
     IMAGE_FORMAT GetImageFormatFromPath(std::string_view path)
     {
         if (String::EndsWith(path, ".png", true))
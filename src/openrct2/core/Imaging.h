@@ -52,4 +52,23 @@ namespace Imaging
     void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
 
     void SetReader(IMAGE_FORMAT format, ImageReaderFunc impl);
+
+    /**
+     * Writes an 8-bit paletted PNG file a few rows at a time, so only the rows being written have to be kept in memory.
+     * The rows must be written from top to bottom by one thread at a time, all methods throw if writing fails.
+     */
+    class PngWriter
+    {
+        struct Impl;
+        std::unique_ptr<Impl> _impl;
+
+    public:
+        PngWriter(std::string_view path, uint32_t width, uint32_t height, const GamePalette& palette);
+        ~PngWriter();
+
+        void WriteRows(const uint8_t* pixels, uint32_t numRows, uint32_t stride);
+
+        // Writes the end of the image once all the rows have been written.
+        void Finish();
+    };
 } // namespace Imaging
@@ -9,21 +9,87 @@
 
 #include "JobPool.h"
 
-#include <algorithm>
 #include <cassert>
 
-JobPool::TaskData::TaskData(std::function<void()> workFn, std::function<void()> completionFn)
-    : WorkFn(workFn)
-    , CompletionFn(completionFn)
+struct WorkerContext
 {
+    const JobPool* Pool;
+    int32_t QueueIndex;
+};
+
+static thread_local WorkerContext _currentWorker = { nullptr, -1 };
+
+bool JobPool::WorkStealingDeque::Push(Job* job)
+{
+    const auto bottom = _bottom.load(std::memory_order_relaxed);
+    const auto top = _top.load(std::memory_order_acquire);
+    if (bottom - top >= Capacity)
+    {
+        return false;
+    }
+
+    _jobs[bottom & Mask].store(job, std::memory_order_relaxed);
+    _bottom.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+JobPool::Job* JobPool::WorkStealingDeque::Pop()
+{
+    const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        // Deque was empty.
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto* job = _jobs[bottom & Mask].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+        // Last job, race against the thieves for it.
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            job = nullptr;
+        }
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+JobPool::Job* JobPool::WorkStealingDeque::Steal()
+{
+    auto top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto bottom = _bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+    {
+        return nullptr;
+    }
+
+    auto* job = _jobs[top & Mask].load(std::memory_order_relaxed);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        // Lost the race against another thief or the owner.
+        return nullptr;
+    }
+    return job;
 }
 
 JobPool::JobPool(size_t maxThreads)
 {
-    maxThreads = std::min<size_t>(maxThreads, std::thread::hardware_concurrency());
-    for (size_t n = 0; n < maxThreads; n++)
+    // The thread waiting on a task group executes jobs as well, so leave a core for it.
+    const size_t hardwareThreads = std::thread::hardware_concurrency();
+    _numWorkers = std::min<size_t>(maxThreads, std::max<size_t>(hardwareThreads, 2) - 1);
+
+    _queues = std::make_unique<WorkStealingDeque[]>(_numWorkers + MaxExternalQueues);
+    for (size_t n = 0; n < _numWorkers; n++)
     {
-        _threads.emplace_back(&JobPool::ProcessQueue, this);
+        _threads.emplace_back(&JobPool::ProcessQueue, this, n);
     }
 }
 
@@ -42,85 +108,229 @@ JobPool::~JobPool()
     }
 }
 
-void JobPool::AddTask(std::function<void()> workFn, std::function<void()> completionFn)
+JobPool& JobPool::GetShared()
 {
-    unique_lock lock(_mutex);
-    _pending.emplace_back(workFn, completionFn);
-    _condPending.notify_one();
+    static JobPool sharedPool;
+    return sharedPool;
 }
 
-void JobPool::Join(std::function<void()> reportFn)
+int32_t JobPool::GetQueueIndex(const TaskGroup& group) const
 {
-    unique_lock lock(_mutex);
-    while (true)
+    if (_currentWorker.Pool == this)
     {
-        // Wait for the queue to become empty or having completed tasks.
-        _condComplete.wait(lock, [this]() { return (_pending.empty() && _processing == 0) || !_completed.empty(); });
+        return _currentWorker.QueueIndex;
+    }
+    return group._queueIndex;
+}
 
-        // Dispatch all completion callbacks if there are any.
-        while (!_completed.empty())
+int32_t JobPool::AcquireExternalQueue()
+{
+    for (size_t n = 0; n < MaxExternalQueues; n++)
+    {
+        if (!_externalQueueInUse[n].exchange(true, std::memory_order_acquire))
         {
-            auto taskData = _completed.front();
-            _completed.pop_front();
+            return static_cast<int32_t>(_numWorkers + n);
+        }
+    }
+    return -1;
+}
 
-            if (taskData.CompletionFn)
-            {
-                lock.unlock();
+void JobPool::ReleaseExternalQueue(int32_t queueIndex)
+{
+    _externalQueueInUse[queueIndex - _numWorkers].store(false, std::memory_order_release);
+}
 
-                taskData.CompletionFn();
+void JobPool::Submit(Job& job, TaskGroup& group)
+{
+    job.Group = &group;
 
-                lock.lock();
-            }
+    if (_currentWorker.Pool != this && group._queueIndex == -1)
+    {
+        group._queueIndex = AcquireExternalQueue();
+    }
+
+    // Run the job straight away if there is no deque available to this thread or it is full.
+    const auto queueIndex = GetQueueIndex(group);
+    if (queueIndex == -1 || !_queues[queueIndex].Push(&job))
+    {
+        RunJob(job);
+        return;
+    }
+
+    _submitted.fetch_add(1);
+    if (_sleeping.load() != 0 || _waiting.load() != 0)
+    {
+        unique_lock lock(_mutex);
+        _condPending.notify_one();
+    }
+}
+
+void JobPool::Wait(TaskGroup& group)
+{
+    static constexpr int32_t SpinCount = 64;
+
+    const auto queueIndex = GetQueueIndex(group);
+    int32_t spin = 0;
+    while (group._pending.load(std::memory_order_acquire) != 0)
+    {
+        const auto submitted = _submitted.load();
+
+        auto* job = FindJob(queueIndex);
+        if (job != nullptr)
+        {
+            RunJob(*job);
+            spin = 0;
+        }
+        else if (spin < SpinCount)
+        {
+            std::this_thread::yield();
+            spin++;
         }
+        else
+        {
+            // The remaining tasks are running on other threads, sleep until one of them completes the group or new
+            // jobs are submitted that this thread can help with.
+            unique_lock lock(_mutex);
+            _waiting++;
+            _condPending.wait(lock, [this, &group, submitted]() {
+                return _shouldStop || group._pending.load() == 0 || _submitted.load() != submitted;
+            });
+            _waiting--;
+            spin = 0;
+        }
+    }
 
-        if (reportFn)
+    // All jobs of the group are done, so its deque is empty and can be handed to another thread.
+    if (group._queueIndex != -1)
+    {
+        ReleaseExternalQueue(group._queueIndex);
+        group._queueIndex = -1;
+    }
+    group._numTasks = 0;
+}
+
+JobPool::Job* JobPool::FindJob(int32_t ownQueueIndex)
+{
+    if (ownQueueIndex != -1)
+    {
+        auto* job = _queues[ownQueueIndex].Pop();
+        if (job != nullptr)
         {
-            lock.unlock();
+            return job;
+        }
+    }
 
-            reportFn();
+    // Start stealing after our own deque so not every thread hammers the same victim.
+    const auto numQueues = _numWorkers + MaxExternalQueues;
+    const auto start = static_cast<size_t>(ownQueueIndex + 1);
+    for (size_t n = 0; n < numQueues; n++)
+    {
+        const auto victim = (start + n) % numQueues;
+        if (static_cast<int32_t>(victim) == ownQueueIndex)
+        {
+            continue;
+        }
 
-            lock.lock();
+        auto* job = _queues[victim].Steal();
+        if (job != nullptr)
+        {
+            return job;
         }
+    }
+    return nullptr;
+}
 
-        // If everything is empty and no more work has to be done we can stop waiting.
-        if (_completed.empty() && _pending.empty() && _processing == 0)
+void JobPool::RunJob(Job& job)
+{
+    // The group may be destroyed as soon as the pending count drops, so do not touch the job afterwards.
+    auto* group = job.Group;
+    try
+    {
+        job.Execute(job);
+    }
+    catch (...)
+    {
+        if (!group->_failed.exchange(true, std::memory_order_relaxed))
         {
-            break;
+            group->_exception = std::current_exception();
         }
     }
+
+    if (group->_pending.fetch_sub(1) == 1 && _waiting.load() != 0)
+    {
+        unique_lock lock(_mutex);
+        _condPending.notify_all();
+    }
 }
 
-size_t JobPool::CountPending()
+void JobPool::RunInBackground(std::function<void()> fn)
 {
+    if (_numWorkers == 0)
+    {
+        RunBackgroundJob(fn);
+        return;
+    }
+
+    // Every sleeper is woken as a thread waiting on a task group may be the one picking up the notification.
     unique_lock lock(_mutex);
-    return _pending.size();
+    _backgroundJobs.push_back(std::move(fn));
+    _condPending.notify_all();
 }
 
-void JobPool::ProcessQueue()
+void JobPool::RunBackgroundJob(std::function<void()>& fn)
 {
-    unique_lock lock(_mutex);
-    do
+    try
     {
-        // Wait for work or cancellation.
-        _condPending.wait(lock, [this]() { return _shouldStop || !_pending.empty(); });
+        fn();
+    }
+    catch (...)
+    {
+        // Nothing waits on a background job that could be handed the exception.
+    }
+}
 
-        if (!_pending.empty())
-        {
-            _processing++;
+void JobPool::ProcessQueue(size_t workerIndex)
+{
+    static constexpr int32_t SpinCount = 64;
 
-            auto taskData = _pending.front();
-            _pending.pop_front();
+    _currentWorker = { this, static_cast<int32_t>(workerIndex) };
 
-            lock.unlock();
-
-            taskData.WorkFn();
+    while (!_shouldStop)
+    {
+        const auto submitted = _submitted.load();
 
-            lock.lock();
+        Job* job = nullptr;
+        for (int32_t spin = 0; spin < SpinCount && job == nullptr; spin++)
+        {
+            job = FindJob(static_cast<int32_t>(workerIndex));
+            if (job == nullptr)
+            {
+                std::this_thread::yield();
+            }
+        }
 
-            _completed.push_back(std::move(taskData));
+        if (job != nullptr)
+        {
+            RunJob(*job);
+            continue;
+        }
 
-            _processing--;
-            _condComplete.notify_one();
+        // Nothing to steal, run a background job or sleep until new jobs are submitted.
+        unique_lock lock(_mutex);
+        if (!_backgroundJobs.empty())
+        {
+            auto fn = std::move(_backgroundJobs.front());
+            _backgroundJobs.pop_front();
+            lock.unlock();
+            RunBackgroundJob(fn);
+            continue;
         }
-    } while (!_shouldStop);
+        _sleeping++;
+        _condPending.wait(lock, [this, submitted]() {
+            return _shouldStop || _submitted.load() != submitted || !_backgroundJobs.empty();
+        });
+        _sleeping--;
+    }
+
+    _currentWorker = { nullptr, -1 };
 }
@@ -9,44 +9,236 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <exception>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+/**
+ * Work-stealing job scheduler.
+ *
+ * Every worker thread owns a lock-free deque, jobs submitted from a worker are pushed onto its own deque and idle
+ * workers steal from the deques of the others. Threads outside of the pool borrow one of a few external deques for
+ * the lifetime of a task group and help executing jobs while they wait for it. Background jobs are kept apart and
+ * are only picked up by idle workers.
+ */
 class JobPool
 {
+public:
+    class TaskGroup;
+
+    struct Job
+    {
+        void (*Execute)(Job& job) = nullptr;
+        TaskGroup* Group = nullptr;
+    };
+
 private:
-    struct TaskData
+    /**
+     * Bounded Chase-Lev deque, the owning thread pushes and pops at the bottom while other threads steal from the top.
+     */
+    class WorkStealingDeque
     {
-        const std::function<void()> WorkFn;
-        const std::function<void()> CompletionFn;
+        static constexpr int64_t Capacity = 1024;
+        static constexpr int64_t Mask = Capacity - 1;
 
-        TaskData(std::function<void()> workFn, std::function<void()> completionFn);
+        alignas(64) std::atomic<int64_t> _top{ 0 };
+        alignas(64) std::atomic<int64_t> _bottom{ 0 };
+        std::array<std::atomic<Job*>, Capacity> _jobs{};
+
+    public:
+        bool Push(Job* job);
+        Job* Pop();
+        Job* Steal();
     };
 
-    std::atomic_bool _shouldStop = { false };
-    std::atomic<size_t> _processing = { 0 };
+    static constexpr size_t MaxExternalQueues = 4;
+
+    size_t _numWorkers{};
     std::vector<std::thread> _threads;
-    std::deque<TaskData> _pending;
-    std::deque<TaskData> _completed;
+    std::unique_ptr<WorkStealingDeque[]> _queues;
+    std::array<std::atomic_bool, MaxExternalQueues> _externalQueueInUse{};
+    std::atomic_bool _shouldStop = { false };
+    std::atomic<uint64_t> _submitted = { 0 };
+    std::atomic<uint32_t> _sleeping = { 0 };
+    std::atomic<uint32_t> _waiting = { 0 };
+    std::deque<std::function<void()>> _backgroundJobs;
     std::condition_variable _condPending;
-    std::condition_variable _condComplete;
     std::mutex _mutex;
 
     using unique_lock = std::unique_lock<std::mutex>;
 
 public:
-    JobPool(size_t maxThreads = 255);
+    explicit JobPool(size_t maxThreads = 255);
     ~JobPool();
 
-    void AddTask(std::function<void()> workFn, std::function<void()> completionFn = nullptr);
-    void Join(std::function<void()> reportFn = nullptr);
-    size_t CountPending();
+    /**
+     * Returns the pool shared by the whole game, the worker threads are created on first use.
+     */
+    static JobPool& GetShared();
+
+    size_t GetWorkerCount() const
+    {
+        return _numWorkers;
+    }
+
+    /**
+     * Calls fn(i) for every i in [0, count). Indices are handed out dynamically in chunks of grainSize so a few slow
+     * items do not hold up the others, the calling thread takes part in the work.
+     */
+    template<typename TFunc> void ParallelFor(size_t count, TFunc&& fn, size_t grainSize = 1);
+
+    /**
+     * Queues fn to run on the next idle worker, for long running work the caller polls for rather than waits on.
+     * Threads waiting on a task group never pick it up, so it can not hold them up. Exceptions thrown by fn are
+     * dropped. Runs fn straight away if the pool has no workers.
+     */
+    void RunInBackground(std::function<void()> fn);
+
+private:
+    void Submit(Job& job, TaskGroup& group);
+    void Wait(TaskGroup& group);
+    int32_t GetQueueIndex(const TaskGroup& group) const;
+    int32_t AcquireExternalQueue();
+    void ReleaseExternalQueue(int32_t queueIndex);
+    Job* FindJob(int32_t ownQueueIndex);
+    void RunJob(Job& job);
+    static void RunBackgroundJob(std::function<void()>& fn);
+    void ProcessQueue(size_t workerIndex);
+};
+
+/**
+ * Set of tasks that can be waited on. Tasks are stored inside the group, so running a task does not allocate once
+ * the group has been used for the same amount of tasks before. A group must only be used by the thread that created
+ * it, the tasks themselves may create their own groups.
+ */
+class JobPool::TaskGroup
+{
+    friend class JobPool;
+
+    static constexpr size_t TaskStorageSize = 96;
+    static constexpr size_t TasksPerBlock = 32;
+
+    struct Task : Job
+    {
+        alignas(std::max_align_t) std::byte Storage[TaskStorageSize];
+    };
+    using TaskBlock = std::array<Task, TasksPerBlock>;
+
+    JobPool& _pool;
+    std::atomic<size_t> _pending = { 0 };
+    std::atomic_bool _failed = { false };
+    std::exception_ptr _exception;
+    int32_t _queueIndex = -1;
+    size_t _numTasks{};
+    TaskBlock _inlineTasks;
+    std::vector<std::unique_ptr<TaskBlock>> _blocks;
+
+public:
+    explicit TaskGroup(JobPool& pool)
+        : _pool(pool)
+    {
+    }
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup()
+    {
+        // Exceptions of tasks that were never waited on are dropped, a destructor must not throw.
+        _pool.Wait(*this);
+    }
+
+    template<typename TFunc> void Run(TFunc&& fn)
+    {
+        using TFn = std::decay_t<TFunc>;
+        static_assert(sizeof(TFn) <= TaskStorageSize, "Task is too large, capture less state by value.");
+        static_assert(alignof(TFn) <= alignof(std::max_align_t));
+
+        auto& task = AllocateTask();
+        new (task.Storage) TFn(std::forward<TFunc>(fn));
+        task.Execute = [](Job& job) {
+            auto& fnRef = *std::launder(reinterpret_cast<TFn*>(static_cast<Task&>(job).Storage));
+            struct Destroy
+            {
+                TFn& Fn;
+                ~Destroy()
+                {
+                    Fn.~TFn();
+                }
+            } destroy{ fnRef };
+            fnRef();
+        };
+
+        _pending.fetch_add(1, std::memory_order_relaxed);
+        _pool.Submit(task, *this);
+    }
+
+    /**
+     * Blocks until all tasks of the group have completed, the calling thread executes pending jobs meanwhile. If any
+     * task threw, the first exception is rethrown once all tasks are done.
+     */
+    void Wait()
+    {
+        _pool.Wait(*this);
+        if (_failed.exchange(false, std::memory_order_relaxed))
+        {
+            std::rethrow_exception(std::exchange(_exception, nullptr));
+        }
+    }
 
 private:
-    void ProcessQueue();
+    Task& AllocateTask()
+    {
+        const auto index = _numTasks++;
+        if (index < TasksPerBlock)
+            return _inlineTasks[index];
+
+        const auto blockIndex = (index / TasksPerBlock) - 1;
+        if (blockIndex >= _blocks.size())
+            _blocks.push_back(std::make_unique<TaskBlock>());
+        return (*_blocks[blockIndex])[index % TasksPerBlock];
+    }
 };
+
+template<typename TFunc> void JobPool::ParallelFor(size_t count, TFunc&& fn, size_t grainSize)
+{
+    if (count == 0)
+        return;
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    const auto numChunks = (count + grainSize - 1) / grainSize;
+
+    std::atomic<size_t> next = { 0 };
+    auto runChunks = [&]() {
+        size_t begin;
+        while ((begin = next.fetch_add(grainSize, std::memory_order_relaxed)) < count)
+        {
+            const auto end = std::min(count, begin + grainSize);
+            for (size_t i = begin; i < end; i++)
+            {
+                fn(i);
+            }
+        }
+    };
+
+    TaskGroup group(*this);
+    const auto numHelpers = std::min(_numWorkers, numChunks - 1);
+    for (size_t n = 0; n < numHelpers; n++)
+    {
+        group.Run(runChunks);
+    }
+    runChunks();
+    group.Wait();
+}
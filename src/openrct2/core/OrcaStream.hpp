@@ -9,16 +9,20 @@
 
 #pragma once
 
+#include "../util/Util.h"
 #include "../world/Location.hpp"
 #include "Crypt.h"
 #include "FileStream.h"
 #include "Identifier.hpp"
+#include "JobPool.h"
 #include "MemoryStream.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <stack>
 #include <type_traits>
@@ -37,6 +41,10 @@ namespace OpenRCT2
 
         static constexpr uint32_t COMPRESSION_NONE = 0;
         static constexpr uint32_t COMPRESSION_GZIP = 1;
+        // Independent gzip members that are compressed and decompressed in parallel, see GzipChunked.
+        static constexpr uint32_t COMPRESSION_GZIP_CHUNKED = 2;
+        // The same with Zstandard frames as members, see ZstdChunked.
+        static constexpr uint32_t COMPRESSION_ZSTD_CHUNKED = 3;
 
     private:
 #pragma pack(push, 1)
@@ -68,6 +76,15 @@ namespace OpenRCT2
         std::vector<ChunkEntry> _chunks;
         MemoryStream _buffer;
         ChunkEntry _currentChunk;
+        int32_t _compressionLevel = GzipLevelDefault;
+
+        // Chunked data is only decompressed for the chunks that are read, the stream has to stay open until then.
+        ChunkedIndex _chunkedIndex;
+        uint64_t _compressedDataStart{};
+        std::vector<std::vector<uint8_t>> _blocks;
+
+        // Plain gzip data is only decompressed as far as the chunks that have been read.
+        std::unique_ptr<GzipStreamReader> _gzipReader;
 
     public:
         OrcaStream(IStream& stream, const Mode mode)
@@ -85,7 +102,24 @@ namespace OpenRCT2
                     _chunks.push_back(entry);
                 }
 
-                // Read compressed data into buffer (read in blocks)
+                if (IsChunked())
+                {
+                    // Only read where the blocks are, each chunk is decompressed when it is read.
+                    _compressedDataStart = _stream->GetPosition();
+                    _chunkedIndex = ChunkedReadIndex(
+                        *_stream, GetChunkedCodec(), _header.CompressedSize, _header.UncompressedSize);
+                    _blocks.resize(_chunkedIndex.GetNumBlocks());
+                    return;
+                }
+
+                if (_header.Compression == COMPRESSION_GZIP)
+                {
+                    // Reading the chunks at the start, such as the objects and scenario details, stops there.
+                    _gzipReader = std::make_unique<GzipStreamReader>(*_stream, _header.CompressedSize);
+                    return;
+                }
+
+                // Read uncompressed data into buffer (read in blocks)
                 _buffer = MemoryStream{};
                 uint8_t temp[2048];
                 uint64_t bytesLeft = _header.CompressedSize;
@@ -96,18 +130,6 @@ namespace OpenRCT2
                     _buffer.Write(temp, readLen);
                     bytesLeft -= readLen;
                 } while (bytesLeft > 0);
-
-                // Uncompress
-                if (_header.Compression == COMPRESSION_GZIP)
-                {
-                    auto uncompressedData = Ungzip(_buffer.GetData(), _buffer.GetLength());
-                    if (_header.UncompressedSize != uncompressedData.size())
-                    {
-                        // Warning?
-                    }
-                    _buffer.Clear();
-                    _buffer.Write(uncompressedData.data(), uncompressedData.size());
-                }
             }
             else
             {
@@ -136,7 +158,18 @@ namespace OpenRCT2
                 std::optional<std::vector<uint8_t>> compressedBytes;
                 if (_header.Compression == COMPRESSION_GZIP)
                 {
-                    compressedBytes = Gzip(uncompressedData, uncompressedSize);
+                    compressedBytes = Gzip(uncompressedData, uncompressedSize, _compressionLevel);
+                }
+                else if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+                {
+                    compressedBytes = GzipChunked(uncompressedData, uncompressedSize, _compressionLevel);
+                }
+                else if (_header.Compression == COMPRESSION_ZSTD_CHUNKED)
+                {
+                    compressedBytes = ZstdChunked(uncompressedData, uncompressedSize, _compressionLevel);
+                }
+                if (_header.Compression != COMPRESSION_NONE)
+                {
                     if (compressedBytes)
                     {
                         _header.CompressedSize = compressedBytes->size();
@@ -182,6 +215,23 @@ namespace OpenRCT2
             return _header;
         }
 
+        // Ids of the chunks in the order they are stored.
+        std::vector<uint32_t> GetChunkIds() const
+        {
+            std::vector<uint32_t> ids;
+            for (const auto& chunk : _chunks)
+            {
+                ids.push_back(chunk.Id);
+            }
+            return ids;
+        }
+
+        // The level of the codec used when writing, readers do not need to know it.
+        void SetCompressionLevel(int32_t level)
+        {
+            _compressionLevel = level;
+        }
+
         template<typename TFunc> bool ReadWriteChunk(const uint32_t chunkId, TFunc f)
         {
             if (_mode == Mode::READING)
@@ -207,18 +257,119 @@ namespace OpenRCT2
         }
 
     private:
+        bool IsChunked() const
+        {
+            return _header.Compression == COMPRESSION_GZIP_CHUNKED || _header.Compression == COMPRESSION_ZSTD_CHUNKED;
+        }
+
+        ChunkedCodec GetChunkedCodec() const
+        {
+            return _header.Compression == COMPRESSION_ZSTD_CHUNKED ? ChunkedCodec::Zstd : ChunkedCodec::Gzip;
+        }
+
         bool SeekChunk(const uint32_t id)
         {
             const auto result = std::find_if(_chunks.begin(), _chunks.end(), [id](const ChunkEntry& e) { return e.Id == id; });
             if (result != _chunks.end())
             {
+                if (IsChunked())
+                {
+                    ReadChunkBlocks(*result);
+                    return true;
+                }
+
                 const auto offset = result->Offset;
+                if (_gzipReader != nullptr)
+                {
+                    DecompressTo(offset + result->Length);
+                }
                 _buffer.SetPosition(offset);
                 return true;
             }
             return false;
         }
 
+        // Decompresses plain gzip data until the buffer holds everything before end.
+        void DecompressTo(const uint64_t end)
+        {
+            std::array<uint8_t, 16 * 1024> temp;
+            while (_buffer.GetLength() < end)
+            {
+                const auto readLen = static_cast<size_t>(std::min<uint64_t>(end - _buffer.GetLength(), temp.size()));
+                const auto decompressedLen = _gzipReader->Read(temp.data(), readLen);
+                if (decompressedLen == 0)
+                {
+                    throw std::runtime_error("Chunk lies outside of the data");
+                }
+                _buffer.SetPosition(_buffer.GetLength());
+                _buffer.Write(temp.data(), decompressedLen);
+            }
+        }
+
+        // Decompresses the blocks the chunk lies in that have not been read yet and puts the chunk in the buffer.
+        void ReadChunkBlocks(const ChunkEntry& chunk)
+        {
+            // Copies, the entry is packed.
+            const uint64_t chunkOffset = chunk.Offset;
+            const uint64_t chunkEnd = chunk.Offset + chunk.Length;
+            if (chunkEnd < chunkOffset || chunkEnd > _chunkedIndex.UncompressedSize)
+            {
+                throw std::runtime_error("Chunk lies outside of the data");
+            }
+
+            _buffer.Clear();
+            if (chunkEnd == chunkOffset)
+            {
+                return;
+            }
+
+            const size_t blockSize = _chunkedIndex.BlockSize;
+            const auto firstBlock = static_cast<size_t>(chunkOffset / blockSize);
+            const auto lastBlock = static_cast<size_t>((chunkEnd - 1) / blockSize);
+
+            // Read the members from the stream one after the other, then decompress them in parallel.
+            std::vector<size_t> missingBlocks;
+            std::vector<std::vector<uint8_t>> members;
+            for (auto block = firstBlock; block <= lastBlock; block++)
+            {
+                if (_blocks[block].empty())
+                {
+                    auto& member = members.emplace_back(_chunkedIndex.GetMemberLength(block));
+                    _stream->SetPosition(_compressedDataStart + _chunkedIndex.MemberOffsets[block]);
+                    _stream->Read(member.data(), member.size());
+                    missingBlocks.push_back(block);
+                }
+            }
+
+            std::atomic<bool> failed{ false };
+            JobPool::GetShared().ParallelFor(missingBlocks.size(), [&](size_t i) {
+                const auto block = missingBlocks[i];
+                std::vector<uint8_t> data(_chunkedIndex.GetBlockLength(block));
+                try
+                {
+                    DecompressChunkedBlock(_chunkedIndex, block, members[i].data(), data.data());
+                    _blocks[block] = std::move(data);
+                }
+                catch (const std::exception&)
+                {
+                    failed = true;
+                }
+            });
+            if (failed)
+            {
+                throw std::runtime_error("Failed to decompress chunk");
+            }
+
+            for (auto block = firstBlock; block <= lastBlock; block++)
+            {
+                const auto blockStart = static_cast<uint64_t>(block) * blockSize;
+                const auto copyStart = std::max(chunkOffset, blockStart);
+                const auto copyEnd = std::min<uint64_t>(chunkEnd, blockStart + _blocks[block].size());
+                _buffer.Write(_blocks[block].data() + (copyStart - blockStart), static_cast<size_t>(copyEnd - copyStart));
+            }
+            _buffer.SetPosition(0);
+        }
+
     public:
         class ChunkStream
         {
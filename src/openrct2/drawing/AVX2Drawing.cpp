@@ -42,6 +42,74 @@ void MaskAvx2(
     }
 }
 
+// Maps every byte of indices through a 256 entry table, the table is repeated in both 128 bit lanes as pshufb does not
+// cross them.
+static __m256i RemapAvx2(const __m256i (&table)[16], __m256i indices)
+{
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+    const __m256i lowNibbles = _mm256_and_si256(indices, nibbleMask);
+    const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi16(indices, 4), nibbleMask);
+    __m256i result = _mm256_setzero_si256();
+    for (int32_t i = 0; i < 16; i++)
+    {
+        const __m256i selected = _mm256_cmpeq_epi8(highNibbles, _mm256_set1_epi8(static_cast<char>(i)));
+        result = _mm256_or_si256(result, _mm256_and_si256(_mm256_shuffle_epi8(table[i], lowNibbles), selected));
+    }
+    return result;
+}
+
+static void LoadRemapTableAvx2(const uint8_t* paletteTable, __m256i (&table)[16])
+{
+    for (int32_t i = 0; i < 16; i++)
+    {
+        table[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(paletteTable + i * 16)));
+    }
+}
+
+void RLERemapSrcRunAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels)
+{
+    if (numPixels >= 32)
+    {
+        __m256i table[16];
+        LoadRemapTableAvx2(paletteTable, table);
+        const __m256i zero = _mm256_setzero_si256();
+        for (; numPixels >= 32; numPixels -= 32)
+        {
+            const __m256i colour = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+            const __m256i remapped = RemapAvx2(table, colour);
+            const __m256i skip = _mm256_or_si256(_mm256_cmpeq_epi8(colour, zero), _mm256_cmpeq_epi8(remapped, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_blendv_epi8(remapped, dest, skip));
+            src += 32;
+            dst += 32;
+        }
+    }
+    RLERemapSrcRunScalar(src, dst, paletteTable, numPixels);
+}
+
+void RLERemapDstRunAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels)
+{
+    if (numPixels >= 32)
+    {
+        __m256i table[16];
+        LoadRemapTableAvx2(paletteTable, table);
+        const __m256i zero = _mm256_setzero_si256();
+        for (; numPixels >= 32; numPixels -= 32)
+        {
+            const __m256i colour = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+            const __m256i remapped = RemapAvx2(table, dest);
+            const __m256i skip = _mm256_or_si256(_mm256_cmpeq_epi8(colour, zero), _mm256_cmpeq_epi8(remapped, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_blendv_epi8(remapped, dest, skip));
+            src += 32;
+            dst += 32;
+        }
+    }
+    RLERemapDstRunScalar(src, dst, paletteTable, numPixels);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +123,16 @@ void MaskAvx2(
     Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void RLERemapSrcRunAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels)
+{
+    Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void RLERemapDstRunAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels)
+{
+    Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
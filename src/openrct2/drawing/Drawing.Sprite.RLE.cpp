@@ -9,9 +9,65 @@
 
 #include "Drawing.h"
 
+#include "../sprites.h"
+#include "SpriteCache.h"
+
 #include <algorithm>
 #include <cstring>
 
+void RLERemapSrcRunScalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels)
+{
+    for (int32_t i = 0; i < numPixels; i++)
+    {
+        if (src[i] != 0)
+        {
+            auto pixel = paletteTable[src[i]];
+            if (pixel != 0)
+            {
+                dst[i] = pixel;
+            }
+        }
+    }
+}
+
+void RLERemapDstRunScalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels)
+{
+    for (int32_t i = 0; i < numPixels; i++)
+    {
+        if (src[i] != 0)
+        {
+            auto pixel = paletteTable[dst[i]];
+            if (pixel != 0)
+            {
+                dst[i] = pixel;
+            }
+        }
+    }
+}
+
+/**
+ * Returns the run function for the blend op and palette map, nullptr when the pixels have to be blitted one by one.
+ * Blending source and destination together stays per pixel as it needs the two dimensional blend map.
+ */
+template<DrawBlendOp TBlendOp>
+static RLERunFunc GetRLERunFunction(const RLERunFunctions& runFunctions, const PaletteMap& paletteMap)
+{
+    if constexpr (TBlendOp == (BLEND_TRANSPARENT | BLEND_SRC))
+    {
+        return paletteMap.GetLookupTable() != nullptr ? runFunctions.RemapSrc : nullptr;
+    }
+    else if constexpr (TBlendOp == (BLEND_TRANSPARENT | BLEND_DST))
+    {
+        return paletteMap.GetLookupTable() != nullptr ? runFunctions.RemapDst : nullptr;
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
 template<DrawBlendOp TBlendOp, size_t TZoom>
 static void FASTCALL DrawRLESpriteMagnify(DrawPixelInfo& dpi, const DrawSpriteArgs& args)
 {
@@ -95,6 +151,13 @@ static void FASTCALL DrawRLESpriteMinify(DrawPixelInfo& dpi, const DrawSpriteArg
     auto zoom = 1 << TZoom;
     auto dstLineWidth = (static_cast<size_t>(dpi.width) >> TZoom) + dpi.pitch;
 
+    // Every source pixel of a run lands on the destination at zoom level 0, so whole runs can be blitted at once.
+    RLERunFunc runFunc = nullptr;
+    if constexpr (TZoom == 0)
+    {
+        runFunc = GetRLERunFunction<TBlendOp>(GetRLERunFunctions(), args.PalMap);
+    }
+
     // Move up to the first line of the image if source_y_start is negative. Why does this even occur?
     if (srcY < 0)
     {
@@ -163,6 +226,13 @@ static void FASTCALL DrawRLESpriteMinify(DrawPixelInfo& dpi, const DrawSpriteArg
                     std::memcpy(dst, src, numPixels);
                 }
             }
+            else if (runFunc != nullptr)
+            {
+                if (numPixels > 0)
+                {
+                    runFunc(src, dst, args.PalMap.GetLookupTable(), numPixels);
+                }
+            }
             else
             {
                 auto& paletteMap = args.PalMap;
@@ -178,6 +248,50 @@ static void FASTCALL DrawRLESpriteMinify(DrawPixelInfo& dpi, const DrawSpriteArg
     }
 }
 
+/**
+ * Draws the sprite through its minified version from the sprite cache, which only holds the pixels drawn at this zoom
+ * level. Returns false if the sprite is not cached and has to be minified while drawing.
+ */
+template<DrawBlendOp TBlendOp, size_t TZoom>
+static bool FASTCALL DrawRLESpriteCached(DrawPixelInfo& dpi, const DrawSpriteArgs& args)
+{
+    // The temporary image is replaced all the time.
+    const auto imageIndex = args.Image.GetIndex();
+    if (imageIndex == SPR_TEMP)
+        return false;
+
+    auto dst0 = args.DestinationBits;
+    auto srcX = args.SrcX;
+    auto srcY = args.SrcY;
+    auto height = args.Height;
+    auto zoom = 1 << TZoom;
+    auto dstLineWidth = (static_cast<size_t>(dpi.width) >> TZoom) + dpi.pitch;
+
+    // Same adjustment as DrawRLESpriteMinify.
+    if (srcY < 0)
+    {
+        srcY += zoom;
+        height -= zoom;
+        dst0 += dstLineWidth;
+    }
+    if (height <= 0 || args.Width <= 0)
+        return true;
+
+    auto sprite = SpriteCacheGetMinified(imageIndex, args.SourceImage, TZoom, srcX & (zoom - 1), srcY & (zoom - 1));
+    if (sprite == nullptr)
+        return false;
+
+    // Every pixel of the minified sprite is drawn, one destination pixel per source pixel.
+    DrawPixelInfo minifiedDpi = dpi;
+    minifiedDpi.width = dpi.width >> TZoom;
+    minifiedDpi.zoom_level = ZoomLevel{ 0 };
+    DrawSpriteArgs minifiedArgs(
+        args.Image, args.PalMap, sprite->Element, srcX >> TZoom, srcY >> TZoom, (args.Width + zoom - 1) >> TZoom,
+        (height + zoom - 1) >> TZoom, dst0);
+    DrawRLESpriteMinify<TBlendOp, 0>(minifiedDpi, minifiedArgs);
+    return true;
+}
+
 template<DrawBlendOp TBlendOp> static void FASTCALL DrawRLESprite(DrawPixelInfo& dpi, const DrawSpriteArgs& args)
 {
     auto zoom_level = static_cast<int8_t>(dpi.zoom_level);
@@ -193,13 +307,16 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawRLESprite(DrawPixelInfo&
             DrawRLESpriteMinify<TBlendOp, 0>(dpi, args);
             break;
         case 1:
-            DrawRLESpriteMinify<TBlendOp, 1>(dpi, args);
+            if (!DrawRLESpriteCached<TBlendOp, 1>(dpi, args))
+                DrawRLESpriteMinify<TBlendOp, 1>(dpi, args);
             break;
         case 2:
-            DrawRLESpriteMinify<TBlendOp, 2>(dpi, args);
+            if (!DrawRLESpriteCached<TBlendOp, 2>(dpi, args))
+                DrawRLESpriteMinify<TBlendOp, 2>(dpi, args);
             break;
         case 3:
-            DrawRLESpriteMinify<TBlendOp, 3>(dpi, args);
+            if (!DrawRLESpriteCached<TBlendOp, 3>(dpi, args))
+                DrawRLESpriteMinify<TBlendOp, 3>(dpi, args);
             break;
         default:
             assert(false);
@@ -21,6 +21,7 @@
 #include "../ui/UiContext.h"
 #include "../util/Util.h"
 #include "ScrollingText.h"
+#include "SpriteCache.h"
 
 #include <algorithm>
 #include <memory>
@@ -243,6 +244,7 @@ bool GfxLoadG1(const IPlatformEnvironment& env)
 
 void GfxUnloadG1()
 {
+    SpriteCacheInvalidate();
     _g1.data.reset();
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
@@ -250,6 +252,7 @@ void GfxUnloadG1()
 
 void GfxUnloadG2()
 {
+    SpriteCacheInvalidate();
     _g2.data.reset();
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
@@ -257,6 +260,7 @@ void GfxUnloadG2()
 
 void GfxUnloadCsg()
 {
+    SpriteCacheInvalidate();
     _csg.data.reset();
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
@@ -781,6 +785,7 @@ void GfxSetG1Element(ImageIndex imageId, const G1Element* g1)
         }
         else if (isValid)
         {
+            SpriteCacheInvalidate();
             if (imageId < SPR_RCTC_G1_END)
             {
                 if (imageId < static_cast<ImageIndex>(_g1.elements.size()))
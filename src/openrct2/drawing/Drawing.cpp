@@ -737,6 +737,32 @@ void MaskFn(
     MaskFunc(width, height, maskSrc, colourSrc, dst, maskWrap, colourWrap, dstWrap);
 }
 
+static RLERunFunctions GetRLERunFunctionsForCPU()
+{
+    if (AVX2Available())
+    {
+        LOG_VERBOSE("registering AVX2 RLE run functions");
+        return { RLERemapSrcRunAvx2, RLERemapDstRunAvx2 };
+    }
+    else if (SSE41Available())
+    {
+        LOG_VERBOSE("registering SSE4.1 RLE run functions");
+        return { RLERemapSrcRunSse4_1, RLERemapDstRunSse4_1 };
+    }
+    else
+    {
+        LOG_VERBOSE("registering scalar RLE run functions");
+        return { RLERemapSrcRunScalar, RLERemapDstRunScalar };
+    }
+}
+
+static const auto RLERunFuncs = GetRLERunFunctionsForCPU();
+
+const RLERunFunctions& GetRLERunFunctions()
+{
+    return RLERunFuncs;
+}
+
 void GfxFilterPixel(DrawPixelInfo& dpi, const ScreenCoordsXY& coords, FilterPaletteID palette)
 {
     GfxFilterRect(dpi, { coords, coords }, palette);
@@ -377,6 +377,14 @@ public:
     uint8_t& operator[](size_t index);
     uint8_t operator[](size_t index) const;
     uint8_t Blend(uint8_t src, uint8_t dst) const;
+
+    /**
+     * Returns the entries of the first map when it covers all 256 palette indices, nullptr otherwise.
+     */
+    const uint8_t* GetLookupTable() const
+    {
+        return _dataLength >= 256 ? _data : nullptr;
+    }
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
 };
 
@@ -602,6 +610,39 @@ void MaskFn(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+/**
+ * Draws a run of RLE sprite pixels through a palette table at zoom level 0, skipping transparent source pixels and
+ * pixels that map to 0, the same as BlitPixel does. The table must have all 256 entries.
+ */
+using RLERunFunc = void (*)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels);
+
+struct RLERunFunctions
+{
+    // BLEND_TRANSPARENT | BLEND_SRC
+    RLERunFunc RemapSrc;
+    // BLEND_TRANSPARENT | BLEND_DST
+    RLERunFunc RemapDst;
+};
+
+void RLERemapSrcRunScalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels);
+void RLERemapDstRunScalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels);
+void RLERemapSrcRunSse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels);
+void RLERemapDstRunSse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels);
+void RLERemapSrcRunAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels);
+void RLERemapDstRunAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels);
+
+/**
+ * Returns the run functions for the best instruction set the CPU supports, the same ones GfxRleSpriteToBuffer uses.
+ */
+const RLERunFunctions& GetRLERunFunctions();
+
 std::optional<uint32_t> GetPaletteG1Index(colour_t paletteId);
 std::optional<PaletteMap> GetPaletteMapForColour(colour_t paletteId);
 void UpdatePalette(const uint8_t* colours, int32_t start_index, int32_t num_colours);
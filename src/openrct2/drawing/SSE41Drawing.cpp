@@ -56,6 +56,73 @@ void MaskSse4_1(
     }
 }
 
+// Maps every byte of indices through a 256 entry table, one pshufb per 16 entries of the table.
+static __m128i RemapSse4_1(const __m128i (&table)[16], __m128i indices)
+{
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i lowNibbles = _mm_and_si128(indices, nibbleMask);
+    const __m128i highNibbles = _mm_and_si128(_mm_srli_epi16(indices, 4), nibbleMask);
+    __m128i result = _mm_setzero_si128();
+    for (int32_t i = 0; i < 16; i++)
+    {
+        const __m128i selected = _mm_cmpeq_epi8(highNibbles, _mm_set1_epi8(static_cast<char>(i)));
+        result = _mm_or_si128(result, _mm_and_si128(_mm_shuffle_epi8(table[i], lowNibbles), selected));
+    }
+    return result;
+}
+
+static void LoadRemapTableSse4_1(const uint8_t* paletteTable, __m128i (&table)[16])
+{
+    for (int32_t i = 0; i < 16; i++)
+    {
+        table[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(paletteTable + i * 16));
+    }
+}
+
+void RLERemapSrcRunSse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels)
+{
+    if (numPixels >= 16)
+    {
+        __m128i table[16];
+        LoadRemapTableSse4_1(paletteTable, table);
+        const __m128i zero = _mm_setzero_si128();
+        for (; numPixels >= 16; numPixels -= 16)
+        {
+            const __m128i colour = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+            const __m128i remapped = RemapSse4_1(table, colour);
+            const __m128i skip = _mm_or_si128(_mm_cmpeq_epi8(colour, zero), _mm_cmpeq_epi8(remapped, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_blendv_epi8(remapped, dest, skip));
+            src += 16;
+            dst += 16;
+        }
+    }
+    RLERemapSrcRunScalar(src, dst, paletteTable, numPixels);
+}
+
+void RLERemapDstRunSse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels)
+{
+    if (numPixels >= 16)
+    {
+        __m128i table[16];
+        LoadRemapTableSse4_1(paletteTable, table);
+        const __m128i zero = _mm_setzero_si128();
+        for (; numPixels >= 16; numPixels -= 16)
+        {
+            const __m128i colour = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+            const __m128i remapped = RemapSse4_1(table, dest);
+            const __m128i skip = _mm_or_si128(_mm_cmpeq_epi8(colour, zero), _mm_cmpeq_epi8(remapped, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_blendv_epi8(remapped, dest, skip));
+            src += 16;
+            dst += 16;
+        }
+    }
+    RLERemapDstRunScalar(src, dst, paletteTable, numPixels);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +136,16 @@ void MaskSse4_1(
     Guard::Fail("SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void RLERemapSrcRunSse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels)
+{
+    Guard::Fail("SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void RLERemapDstRunSse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT paletteTable, int32_t numPixels)
+{
+    Guard::Fail("SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
 #endif // __SSE4_1__
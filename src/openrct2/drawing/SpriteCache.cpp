@@ -0,0 +1,262 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SpriteCache.h"
+
+#include "../config/Config.h"
+
+#include <algorithm>
+#include <iterator>
+
+// RLE runs store their start as a byte and their length in 7 bits.
+static constexpr int32_t MaxRunStart = 255;
+static constexpr int32_t MaxRunLength = 127;
+
+static void DecodeRLELine(const G1Element& g1, int32_t y, uint8_t* line)
+{
+    const auto* src0 = g1.offset;
+    const uint16_t lineOffset = src0[y * 2] | (src0[y * 2 + 1] << 8);
+    auto nextRun = src0 + lineOffset;
+    auto isEndOfLine = false;
+    while (!isEndOfLine)
+    {
+        auto src = nextRun;
+        auto dataSize = *src++;
+        auto firstPixelX = *src++;
+        isEndOfLine = (dataSize & 0x80) != 0;
+        dataSize &= 0x7F;
+        nextRun = src + dataSize;
+
+        const auto numPixels = std::min<int32_t>(dataSize, g1.width - firstPixelX);
+        if (numPixels > 0)
+        {
+            std::copy_n(src, numPixels, line + firstPixelX);
+        }
+    }
+}
+
+std::shared_ptr<const MinifiedSprite> MinifyRLESprite(const G1Element& g1, int32_t zoomShift, int32_t phaseX, int32_t phaseY)
+{
+    const int32_t zoom = 1 << zoomShift;
+    if (g1.offset == nullptr || !(g1.flags & G1_FLAG_RLE_COMPRESSION) || phaseX >= g1.width || phaseY >= g1.height)
+        return nullptr;
+
+    const int32_t width = (g1.width - phaseX + zoom - 1) >> zoomShift;
+    const int32_t height = (g1.height - phaseY + zoom - 1) >> zoomShift;
+    if (width > MaxRunStart + 1)
+        return nullptr;
+
+    auto sprite = std::make_shared<MinifiedSprite>();
+    auto& data = sprite->Data;
+    data.resize(static_cast<size_t>(height) * 2);
+
+    std::vector<uint8_t> line(g1.width);
+    for (int32_t row = 0; row < height; row++)
+    {
+        std::fill(line.begin(), line.end(), 0);
+        DecodeRLELine(g1, phaseY + (row << zoomShift), line.data());
+
+        // Lines are addressed by 16 bit offsets from the start of the image.
+        const auto lineOffset = data.size();
+        if (lineOffset > UINT16_MAX)
+            return nullptr;
+        data[row * 2] = static_cast<uint8_t>(lineOffset & 0xFF);
+        data[row * 2 + 1] = static_cast<uint8_t>(lineOffset >> 8);
+
+        // Transparent pixels are drawn as nothing at every zoom level, so they are left out of the runs.
+        const auto getPixel = [&](int32_t x) { return line[phaseX + (x << zoomShift)]; };
+        auto lastRunHeader = data.size();
+        auto hasRuns = false;
+        for (int32_t x = 0; x < width;)
+        {
+            if (getPixel(x) == 0)
+            {
+                x++;
+                continue;
+            }
+
+            lastRunHeader = data.size();
+            hasRuns = true;
+            data.push_back(0);
+            data.push_back(static_cast<uint8_t>(x));
+            int32_t length = 0;
+            while (x < width && length < MaxRunLength && getPixel(x) != 0)
+            {
+                data.push_back(getPixel(x));
+                x++;
+                length++;
+            }
+            data[lastRunHeader] = static_cast<uint8_t>(length);
+        }
+
+        if (hasRuns)
+        {
+            data[lastRunHeader] |= 0x80;
+        }
+        else
+        {
+            data.push_back(0x80);
+            data.push_back(0);
+        }
+    }
+    data.shrink_to_fit();
+
+    sprite->Element.offset = data.data();
+    sprite->Element.width = static_cast<int16_t>(width);
+    sprite->Element.height = static_cast<int16_t>(height);
+    sprite->Element.flags = G1_FLAG_RLE_COMPRESSION;
+    sprite->SourceData = g1.offset;
+    return sprite;
+}
+
+static uint64_t GetSpriteCacheKey(ImageIndex imageIndex, int32_t zoomShift, int32_t phaseX, int32_t phaseY)
+{
+    return (static_cast<uint64_t>(imageIndex) << 16) | (zoomShift << 8) | (phaseY << 4) | phaseX;
+}
+
+SpriteCache::SpriteCache(size_t budget)
+    : _budget(budget)
+{
+}
+
+std::shared_ptr<const MinifiedSprite> SpriteCache::Get(
+    ImageIndex imageIndex, const G1Element& g1, int32_t zoomShift, int32_t phaseX, int32_t phaseY)
+{
+    if (_budget.load() == 0)
+        return nullptr;
+
+    const auto key = GetSpriteCacheKey(imageIndex, zoomShift, phaseX, phaseY);
+    {
+        std::shared_lock lock(_mutex);
+        auto it = _lookup.find(key);
+        if (it != _lookup.end() && it->second->Sprite->SourceData == g1.offset)
+        {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            it->second->Referenced.store(true, std::memory_order_relaxed);
+            return it->second->Sprite;
+        }
+    }
+    _misses.fetch_add(1, std::memory_order_relaxed);
+
+    // Minify without holding the lock so other threads can keep drawing, the first one to finish adds it.
+    auto sprite = MinifyRLESprite(g1, zoomShift, phaseX, phaseY);
+    if (sprite == nullptr)
+        return nullptr;
+
+    std::unique_lock lock(_mutex);
+    Insert(key, sprite);
+    return sprite;
+}
+
+void SpriteCache::Insert(uint64_t key, std::shared_ptr<const MinifiedSprite> sprite)
+{
+    auto it = _lookup.find(key);
+    if (it != _lookup.end())
+    {
+        _memoryUsage -= it->second->Sprite->GetMemoryUsage();
+        _entries.erase(it->second);
+        _lookup.erase(it);
+    }
+
+    const auto memoryUsage = sprite->GetMemoryUsage();
+    if (memoryUsage > _budget.load())
+        return;
+
+    _entries.emplace_front(key, std::move(sprite));
+    _lookup[key] = _entries.begin();
+    _memoryUsage += memoryUsage;
+    EvictToBudget();
+}
+
+void SpriteCache::EvictToBudget()
+{
+    const auto budget = _budget.load();
+    while (_memoryUsage > budget && !_entries.empty())
+    {
+        auto& entry = _entries.back();
+        if (entry.Referenced.exchange(false, std::memory_order_relaxed))
+        {
+            // Drawn since it was last moved, keep it for another round.
+            _entries.splice(_entries.begin(), _entries, std::prev(_entries.end()));
+            continue;
+        }
+        _memoryUsage -= entry.Sprite->GetMemoryUsage();
+        _lookup.erase(entry.Key);
+        _entries.pop_back();
+        _evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+size_t SpriteCache::GetBudget() const
+{
+    return _budget.load();
+}
+
+void SpriteCache::SetBudget(size_t budget)
+{
+    if (_budget.exchange(budget) > budget)
+    {
+        std::unique_lock lock(_mutex);
+        EvictToBudget();
+    }
+}
+
+void SpriteCache::Clear()
+{
+    std::unique_lock lock(_mutex);
+    _entries.clear();
+    _lookup.clear();
+    _memoryUsage = 0;
+}
+
+SpriteCacheStats SpriteCache::GetStats() const
+{
+    std::shared_lock lock(_mutex);
+    SpriteCacheStats stats;
+    stats.Hits = _hits.load(std::memory_order_relaxed);
+    stats.Misses = _misses.load(std::memory_order_relaxed);
+    stats.Evictions = _evictions.load(std::memory_order_relaxed);
+    stats.NumEntries = _entries.size();
+    stats.MemoryUsage = _memoryUsage;
+    return stats;
+}
+
+void SpriteCache::ResetStats()
+{
+    _hits.store(0, std::memory_order_relaxed);
+    _misses.store(0, std::memory_order_relaxed);
+    _evictions.store(0, std::memory_order_relaxed);
+}
+
+static size_t GetConfiguredBudget()
+{
+    return static_cast<size_t>(std::max(gConfigGeneral.SpriteCacheSize, 0)) * 1024 * 1024;
+}
+
+SpriteCache& GetSpriteCache()
+{
+    static SpriteCache cache(GetConfiguredBudget());
+    return cache;
+}
+
+void SpriteCacheApplyConfig()
+{
+    GetSpriteCache().SetBudget(GetConfiguredBudget());
+}
+
+std::shared_ptr<const MinifiedSprite> SpriteCacheGetMinified(
+    ImageIndex imageIndex, const G1Element& g1, int32_t zoomShift, int32_t phaseX, int32_t phaseY)
+{
+    return GetSpriteCache().Get(imageIndex, g1, zoomShift, phaseX, phaseY);
+}
+
+void SpriteCacheInvalidate()
+{
+    GetSpriteCache().Clear();
+}
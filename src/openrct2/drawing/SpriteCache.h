@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Drawing.h"
+#include "ImageId.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * An RLE sprite with only every zoom'th pixel of every zoom'th line, starting at the given phase, so drawing it at
+ * zoom level 0 draws the same pixels as drawing the original at the zoom level. Transparent runs are left out of the
+ * image, the palette map is still applied when the sprite is drawn.
+ */
+struct MinifiedSprite
+{
+    G1Element Element{};
+    std::vector<uint8_t> Data;
+    // The pixel data of the sprite this was made from, used to detect sprites that have been replaced.
+    const uint8_t* SourceData{};
+
+    size_t GetMemoryUsage() const
+    {
+        return sizeof(MinifiedSprite) + Data.capacity();
+    }
+};
+
+/**
+ * Returns the minified version of an RLE sprite, nullptr if it can not be encoded as an RLE sprite.
+ */
+std::shared_ptr<const MinifiedSprite> MinifyRLESprite(const G1Element& g1, int32_t zoomShift, int32_t phaseX, int32_t phaseY);
+
+struct SpriteCacheStats
+{
+    uint64_t Hits{};
+    uint64_t Misses{};
+    uint64_t Evictions{};
+    size_t NumEntries{};
+    size_t MemoryUsage{};
+};
+
+/**
+ * Cache of minified RLE sprites, so sprites drawn over and over again in zoomed out views are only decoded once. It is
+ * safe to use from the threads drawing the viewport columns.
+ *
+ * Hits only take a shared lock and mark the entry as referenced. Eviction gives referenced entries a second chance
+ * by moving them to the front of the list, which approximates evicting the least recently used sprite.
+ */
+class SpriteCache
+{
+    // Entries are keyed on the image index, zoom and phase only. The palette map is applied when the minified sprite
+    // is drawn, so one entry serves every remap of the same sprite.
+    struct Entry
+    {
+        Entry(uint64_t key, std::shared_ptr<const MinifiedSprite> sprite)
+            : Key(key)
+            , Sprite(std::move(sprite))
+        {
+        }
+
+        uint64_t Key;
+        std::shared_ptr<const MinifiedSprite> Sprite;
+        std::atomic<bool> Referenced{};
+    };
+
+    mutable std::shared_mutex _mutex;
+    std::list<Entry> _entries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> _lookup;
+    std::atomic<size_t> _budget;
+    size_t _memoryUsage{};
+    std::atomic<uint64_t> _hits{};
+    std::atomic<uint64_t> _misses{};
+    std::atomic<uint64_t> _evictions{};
+
+public:
+    explicit SpriteCache(size_t budget);
+
+    /**
+     * Returns the minified sprite, minifying and adding it when it is not in the cache yet. Returns nullptr when the
+     * cache is disabled or the sprite can not be minified.
+     */
+    std::shared_ptr<const MinifiedSprite> Get(
+        ImageIndex imageIndex, const G1Element& g1, int32_t zoomShift, int32_t phaseX, int32_t phaseY);
+
+    size_t GetBudget() const;
+    void SetBudget(size_t budget);
+    void Clear();
+
+    SpriteCacheStats GetStats() const;
+    // Resets the hit, miss and eviction counts.
+    void ResetStats();
+
+private:
+    void Insert(uint64_t key, std::shared_ptr<const MinifiedSprite> sprite);
+    void EvictToBudget();
+};
+
+/**
+ * The cache used by the software renderer, its budget follows the sprite_cache_size setting.
+ */
+SpriteCache& GetSpriteCache();
+
+/**
+ * Sets the budget of the software renderer's cache from the sprite_cache_size setting, called once per frame.
+ */
+void SpriteCacheApplyConfig();
+
+/**
+ * Returns the minified sprite from the software renderer's cache, nullptr if the sprite has to be drawn directly.
+ */
+std::shared_ptr<const MinifiedSprite> SpriteCacheGetMinified(
+    ImageIndex imageIndex, const G1Element& g1, int32_t zoomShift, int32_t phaseX, int32_t phaseY);
+
+/**
+ * Drops all cached sprites, called whenever sprites are loaded, replaced or unloaded.
+ */
+void SpriteCacheInvalidate();
@@ -17,6 +17,7 @@
 #include "../interface/Screenshot.h"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
+#include "../profiling/Profiling.h"
 #include "../ui/UiContext.h"
 #include "../util/Util.h"
 #include "../world/Climate.h"
@@ -204,12 +205,21 @@ void X8DrawingEngine::EndDraw()
 void X8DrawingEngine::PaintWindows()
 {
     WindowResetVisibilities();
+    _dirtyStats = {};
 
     // Redraw dirty regions before updating the viewports, otherwise
     // when viewports get panned, they copy dirty pixels
     DrawAllDirtyBlocks();
     WindowUpdateAllViewports();
     DrawAllDirtyBlocks();
+
+    _lastDirtyStats = _dirtyStats;
+    if (Profiling::IsEnabled())
+    {
+        Profiling::SetCounter("dirty_rects", _dirtyStats.Rects);
+        Profiling::SetCounter("dirty_blocks", _dirtyStats.Blocks);
+        Profiling::SetCounter("dirty_pixels", _dirtyStats.Pixels);
+    }
 }
 
 void X8DrawingEngine::PaintWeather()
@@ -287,6 +297,11 @@ DrawPixelInfo* X8DrawingEngine::GetDPI()
     return &_bitsDPI;
 }
 
+const DirtyStats& X8DrawingEngine::GetLastDirtyStats() const
+{
+    return _lastDirtyStats;
+}
+
 void X8DrawingEngine::ConfigureBits(uint32_t width, uint32_t height, uint32_t pitch)
 {
     size_t newBitsSize = pitch * height;
@@ -364,45 +379,46 @@ void X8DrawingEngine::ConfigureDirtyGrid()
 
 void X8DrawingEngine::DrawAllDirtyBlocks()
 {
-    // TODO: For optimal performance it is currently limited to a single column.
-    // The optimal approach would be to extract all dirty regions as rectangles not including
-    // parts that are not marked dirty and have the grid more fine grained.
-    // A situation like following:
+    // Adjacent dirty blocks are merged into rectangles that contain nothing but dirty blocks, a run of dirty blocks
+    // in a row is extended downwards for as long as all the blocks below it are dirty too. A situation like following:
     //
     //   0 1 2 3 4 5 6 7 8 9
     //   1 - - - - - - - - -
     //   2 - x x x x - - - -
     //   3 - x x - - - - - -
     //   4 - - - - - - - - -
-    //   5 - - - - - - - - -
-    //   6 - - - - - - - - -
-    //   7 - - - - - - - - -
-    //   8 - - - - - - - - -
-    //   9 - - - - - - - - -
     //
-    // Would currently redraw {2,2} to {3,5} where {3,4} and {3,5} are not dirty. Choosing to do this
-    // per column eliminates this issue but limits it to rendering just a single column at a time.
+    // Is drawn as {1,2} to {4,2} and {1,3} to {2,3}, rather than as four single columns.
 
-    for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
+    for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
     {
-        for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
+        uint32_t yOffset = y * _dirtyGrid.BlockColumns;
+        for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
         {
-            uint32_t yOffset = y * _dirtyGrid.BlockColumns;
             if (_dirtyGrid.Blocks[yOffset + x] == 0)
             {
                 continue;
             }
 
-            // See comment above as to why this is 1.
-            const uint32_t columns = 1;
-
-            // Check rows
+            auto columns = GetNumDirtyColumns(x, y);
             auto rows = GetNumDirtyRows(x, y, columns);
             DrawDirtyBlocks(x, y, columns, rows);
+            x += columns - 1;
         }
     }
 }
 
+uint32_t X8DrawingEngine::GetNumDirtyColumns(const uint32_t x, const uint32_t y)
+{
+    uint32_t yOffset = y * _dirtyGrid.BlockColumns;
+    uint32_t xx = x;
+    while (xx < _dirtyGrid.BlockColumns && _dirtyGrid.Blocks[yOffset + xx] != 0)
+    {
+        xx++;
+    }
+    return xx - x;
+}
+
 uint32_t X8DrawingEngine::GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns)
 {
     uint32_t yy = y;
@@ -446,6 +462,10 @@ void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns,
         return;
     }
 
+    _dirtyStats.Rects++;
+    _dirtyStats.Blocks += columns * rows;
+    _dirtyStats.Pixels += static_cast<uint64_t>(right - left) * (bottom - top);
+
     // Draw region
     OnDrawDirtyBlock(x, y, columns, rows);
     WindowDrawAll(_bitsDPI, left, top, right, bottom);
@@ -37,6 +37,15 @@ namespace OpenRCT2
             uint8_t* Blocks;
         };
 
+        // Screen area redrawn by the dirty blocks in a frame.
+        struct DirtyStats
+        {
+            // Number of rectangles drawn after merging adjacent dirty blocks.
+            uint32_t Rects;
+            uint32_t Blocks;
+            uint64_t Pixels;
+        };
+
         class X8WeatherDrawer final : public IWeatherDrawer
         {
         private:
@@ -75,6 +84,8 @@ namespace OpenRCT2
             uint8_t* _bits = nullptr;
 
             DirtyGrid _dirtyGrid = {};
+            DirtyStats _dirtyStats = {};
+            DirtyStats _lastDirtyStats = {};
 
             DrawPixelInfo _bitsDPI = {};
 
@@ -114,6 +125,9 @@ namespace OpenRCT2
 
             DrawPixelInfo* GetDPI();
 
+            // Returns what was redrawn by the last call to PaintWindows.
+            const DirtyStats& GetLastDirtyStats() const;
+
         protected:
             void ConfigureBits(uint32_t width, uint32_t height, uint32_t pitch);
             virtual void OnDrawDirtyBlock(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
@@ -121,6 +135,7 @@ namespace OpenRCT2
         private:
             void ConfigureDirtyGrid();
             void DrawAllDirtyBlocks();
+            uint32_t GetNumDirtyColumns(const uint32_t x, const uint32_t y);
             uint32_t GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns);
             void DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
         };
@@ -0,0 +1,200 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../Identifiers.h"
+#include "../util/Util.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+/**
+ * Set of entity ids that is always traversed in ascending id order, which the game relies on to stay in sync.
+ * Ids are stored as bits in a flat array with a second level of bits marking the non-empty words, inserting and
+ * removing an id is constant time and finding the next id scans at most a few words.
+ */
+class EntityIdSet
+{
+    static constexpr size_t BITS_PER_WORD = 64;
+    static constexpr size_t NUM_IDS = size_t{ EntityId::GetNull().ToUnderlying() } + 1;
+    static constexpr size_t NUM_WORDS = NUM_IDS / BITS_PER_WORD;
+    static constexpr size_t NUM_SUMMARY_WORDS = (NUM_WORDS + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+    std::array<uint64_t, NUM_WORDS> _words{};
+    std::array<uint64_t, NUM_SUMMARY_WORDS> _summary{};
+    size_t _count{};
+
+public:
+    class Iterator
+    {
+        const EntityIdSet* _set;
+        EntityId _id;
+
+    public:
+        Iterator(const EntityIdSet* set, EntityId id)
+            : _set(set)
+            , _id(id)
+        {
+        }
+        Iterator& operator++()
+        {
+            _id = _set->Next(_id);
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+        bool operator==(const Iterator& other) const
+        {
+            return _id == other._id;
+        }
+        bool operator!=(const Iterator& other) const
+        {
+            return !(*this == other);
+        }
+        EntityId operator*() const
+        {
+            return _id;
+        }
+        // iterator traits
+        using difference_type = std::ptrdiff_t;
+        using value_type = EntityId;
+        using pointer = const EntityId*;
+        using reference = const EntityId&;
+        using iterator_category = std::forward_iterator_tag;
+    };
+
+    bool Contains(EntityId id) const
+    {
+        const auto index = id.ToUnderlying();
+        return (_words[index / BITS_PER_WORD] & (1uLL << (index % BITS_PER_WORD))) != 0;
+    }
+
+    /**
+     * Adds the id to the set, returns false if it was already part of it.
+     */
+    bool Insert(EntityId id)
+    {
+        const auto index = id.ToUnderlying();
+        const auto wordIndex = index / BITS_PER_WORD;
+        const auto bit = 1uLL << (index % BITS_PER_WORD);
+        if ((_words[wordIndex] & bit) != 0)
+            return false;
+
+        _words[wordIndex] |= bit;
+        _summary[wordIndex / BITS_PER_WORD] |= 1uLL << (wordIndex % BITS_PER_WORD);
+        _count++;
+        return true;
+    }
+
+    /**
+     * Removes the id from the set, returns false if it was not part of it.
+     */
+    bool Erase(EntityId id)
+    {
+        const auto index = id.ToUnderlying();
+        const auto wordIndex = index / BITS_PER_WORD;
+        const auto bit = 1uLL << (index % BITS_PER_WORD);
+        if ((_words[wordIndex] & bit) == 0)
+            return false;
+
+        _words[wordIndex] &= ~bit;
+        if (_words[wordIndex] == 0)
+        {
+            _summary[wordIndex / BITS_PER_WORD] &= ~(1uLL << (wordIndex % BITS_PER_WORD));
+        }
+        _count--;
+        return true;
+    }
+
+    void Clear()
+    {
+        _words.fill(0);
+        _summary.fill(0);
+        _count = 0;
+    }
+
+    size_t size() const
+    {
+        return _count;
+    }
+
+    bool empty() const
+    {
+        return _count == 0;
+    }
+
+    /**
+     * Returns the lowest id in the set or null if it is empty.
+     */
+    EntityId Front() const
+    {
+        return FindFrom(0);
+    }
+
+    /**
+     * Returns the lowest id in the set that is greater than the given id or null if there is none.
+     */
+    EntityId Next(EntityId id) const
+    {
+        return FindFrom(size_t{ id.ToUnderlying() } + 1);
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(this, Front());
+    }
+    Iterator end() const
+    {
+        return Iterator(this, EntityId::GetNull());
+    }
+
+private:
+    EntityId FindFrom(size_t index) const
+    {
+        if (index >= NUM_IDS)
+            return EntityId::GetNull();
+
+        // Remaining ids in the word of the start index.
+        auto wordIndex = index / BITS_PER_WORD;
+        const auto word = _words[wordIndex] & (~0uLL << (index % BITS_PER_WORD));
+        if (word != 0)
+            return ToId(wordIndex, word);
+
+        // Find the next non-empty word through the summary.
+        wordIndex++;
+        for (auto summaryIndex = wordIndex / BITS_PER_WORD; summaryIndex < NUM_SUMMARY_WORDS; summaryIndex++)
+        {
+            auto summary = _summary[summaryIndex];
+            if (summaryIndex == wordIndex / BITS_PER_WORD)
+            {
+                summary &= ~0uLL << (wordIndex % BITS_PER_WORD);
+            }
+            if (summary != 0)
+            {
+                const auto nextWordIndex = summaryIndex * BITS_PER_WORD
+                    + UtilBitScanForward(static_cast<int64_t>(summary));
+                return ToId(nextWordIndex, _words[nextWordIndex]);
+            }
+        }
+        return EntityId::GetNull();
+    }
+
+    static EntityId ToId(size_t wordIndex, uint64_t word)
+    {
+        const auto bitIndex = UtilBitScanForward(static_cast<int64_t>(word));
+        return EntityId::FromUnderlying(static_cast<EntityId::UnderlyingType>(wordIndex * BITS_PER_WORD + bitIndex));
+    }
+};
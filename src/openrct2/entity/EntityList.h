@@ -12,13 +12,16 @@
 #include "../common.h"
 #include "../rct12/RCT12.h"
 #include "../world/Location.hpp"
+#include "../world/Map.h"
 #include "EntityBase.h"
+#include "EntityIdSet.h"
 #include "EntityRegistry.h"
 
-#include <list>
+#include <algorithm>
+#include <utility>
 #include <vector>
 
-const std::list<EntityId>& GetEntityList(const EntityType id);
+const EntityIdSet& GetEntityList(const EntityType id);
 
 uint16_t GetEntityListCount(EntityType list);
 uint16_t GetMiscEntityCount();
@@ -97,15 +100,83 @@ public:
     }
 };
 
+/**
+ * Calls fn for every entity of type T on the tiles overlapping the square that extends radius units from loc in each
+ * direction. Entities are visited tile by tile and in id order within a tile, callers should not depend on ids being
+ * ascending overall.
+ */
+template<typename T, typename TFunc> void ForEachEntityInRadius(const CoordsXY& loc, int32_t radius, TFunc&& fn)
+{
+    const auto minX = std::max(loc.x - radius, 0) / COORDS_XY_STEP;
+    const auto minY = std::max(loc.y - radius, 0) / COORDS_XY_STEP;
+    const auto maxX = std::min((loc.x + radius) / COORDS_XY_STEP, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    const auto maxY = std::min((loc.y + radius) / COORDS_XY_STEP, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    for (auto tileX = minX; tileX <= maxX; tileX++)
+    {
+        for (auto tileY = minY; tileY <= maxY; tileY++)
+        {
+            for (auto* entity : EntityTileList<T>(TileCoordsXY{ tileX, tileY }.ToCoordsXY()))
+            {
+                fn(*entity);
+            }
+        }
+    }
+}
+
+/**
+ * Returns up to count entities of type T within radius of loc ordered by the distance returned by distanceFn, entities
+ * at the same distance are ordered by id so the result does not depend on where the entities are stored.
+ */
+template<typename T, typename TFunc>
+std::vector<T*> GetNearestEntities(const CoordsXY& loc, int32_t radius, size_t count, TFunc&& distanceFn)
+{
+    std::vector<std::pair<int32_t, T*>> candidates;
+    ForEachEntityInRadius<T>(loc, radius, [&](T& entity) { candidates.emplace_back(distanceFn(entity), &entity); });
+
+    const auto compare = [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first < b.first : a.second->Id.ToUnderlying() < b.second->Id.ToUnderlying();
+    };
+    count = std::min(count, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), compare);
+
+    std::vector<T*> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        result.push_back(candidates[i].second);
+    }
+    return result;
+}
+
+/**
+ * Returns the entity of type T within radius of loc with the smallest distance returned by distanceFn, or nullptr if
+ * there is none. Ties are resolved in favour of the lowest id.
+ */
+template<typename T, typename TFunc> T* GetNearestEntity(const CoordsXY& loc, int32_t radius, TFunc&& distanceFn)
+{
+    T* nearest = nullptr;
+    int32_t nearestDistance = 0;
+    ForEachEntityInRadius<T>(loc, radius, [&](T& entity) {
+        const int32_t distance = distanceFn(entity);
+        if (nearest == nullptr || distance < nearestDistance
+            || (distance == nearestDistance && entity.Id.ToUnderlying() < nearest->Id.ToUnderlying()))
+        {
+            nearest = &entity;
+            nearestDistance = distance;
+        }
+    });
+    return nearest;
+}
+
 template<typename T> class EntityListIterator
 {
 private:
-    std::list<EntityId>::const_iterator iter;
-    std::list<EntityId>::const_iterator end;
+    EntityIdSet::Iterator iter;
+    EntityIdSet::Iterator end;
     T* Entity = nullptr;
 
 public:
-    EntityListIterator(std::list<EntityId>::const_iterator _iter, std::list<EntityId>::const_iterator _end)
+    EntityListIterator(EntityIdSet::Iterator _iter, EntityIdSet::Iterator _end)
         : iter(_iter)
         , end(_end)
     {
@@ -115,6 +186,8 @@ public:
     {
         Entity = nullptr;
 
+        // The set iterator looks up the next id when advancing, so the current entity may be removed and entities
+        // with higher ids may be added while iterating.
         while (iter != end && Entity == nullptr)
         {
             Entity = GetEntity<T>(*iter++);
@@ -126,7 +199,7 @@ public:
     {
         EntityListIterator retval = *this;
         ++(*this);
-        return *iter;
+        return retval;
     }
     bool operator==(EntityListIterator other) const
     {
@@ -152,7 +225,7 @@ template<typename T = EntityBase> class EntityList
 {
 private:
     using EntityListIterator_t = EntityListIterator<T>;
-    const std::list<EntityId>& vec;
+    const EntityIdSet& vec;
 
 public:
     EntityList()
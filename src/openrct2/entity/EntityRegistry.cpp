@@ -27,28 +27,131 @@
 #include "Duck.h"
 #include "EntityTweener.h"
 #include "Fountain.h"
+#include "Litter.h"
 #include "MoneyEffect.h"
 #include "Particle.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <numeric>
 #include <vector>
 
-union Entity
+/**
+ * Storage for all entities of a single type. Slots are only as large as that type and handed out in order of first
+ * use, so entities that are created together, such as guests arriving at the park, end up next to each other in memory.
+ * Chunks are never moved or released until the pool is reset, pointers to entities stay valid while they exist.
+ *
+ * A slot belongs to the id that first used it and is never handed to another id, a removed entity keeps its slot for
+ * when its id is used for this type again. A stale pointer to a removed entity therefore sees either a null entity or
+ * a later entity with the same id, the same guarantee as when entities were stored in one array indexed by id. Each pool
+ * therefore holds a slot for every id it has ever been given, so it is bounded by the highest such id rather than by the
+ * number of entities of its type, and all pools together by about the number of types times the peak id count.
+ *
+ * Entities are not kept dense or in id order within a pool. EntityList still walks the ids of a type and looks each one
+ * up through the id to pointer table, the pools only make the entities smaller and place those created together next to
+ * each other.
+ */
+class EntityPool
 {
-    uint8_t Pad00[0x200];
-    EntityBase base;
-    Entity()
-        : Pad00()
+    static constexpr uint32_t SLOTS_PER_CHUNK = 512;
+    static constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+    size_t _slotSize{};
+    uint32_t _numSlots{};
+    std::vector<std::unique_ptr<std::byte[]>> _chunks;
+    // Slot owned by each id, indexed by id.
+    std::vector<uint32_t> _idSlots;
+
+public:
+    explicit EntityPool(size_t entitySize = 0)
+        // Keep the default alignment of new for every slot.
+        : _slotSize((entitySize + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1))
+    {
+    }
+
+    EntityBase* Allocate(EntityId id)
+    {
+        const auto index = id.ToUnderlying();
+        if (index >= _idSlots.size())
+        {
+            _idSlots.resize(index + 1, NO_SLOT);
+        }
+
+        auto& slot = _idSlots[index];
+        if (slot == NO_SLOT)
+        {
+            slot = _numSlots++;
+            if (slot / SLOTS_PER_CHUNK >= _chunks.size())
+            {
+                _chunks.push_back(std::make_unique<std::byte[]>(_slotSize * SLOTS_PER_CHUNK));
+            }
+        }
+        return GetSlot(slot);
+    }
+
+    size_t GetSlotSize() const
     {
+        return _slotSize;
+    }
+
+    void Reset()
+    {
+        // Keep the chunks around, the next park is likely to need a similar amount of entities.
+        _numSlots = 0;
+        _idSlots.clear();
+    }
+
+private:
+    EntityBase* GetSlot(uint32_t slot) const
+    {
+        return reinterpret_cast<EntityBase*>(&_chunks[slot / SLOTS_PER_CHUNK][(slot % SLOTS_PER_CHUNK) * _slotSize]);
     }
 };
 
-static Entity _entities[MAX_ENTITIES]{};
-static std::array<std::list<EntityId>, EnumValue(EntityType::Count)> gEntityLists;
-static std::vector<EntityId> _freeIdList;
+template<typename... T> static constexpr auto GetEntitySizes()
+{
+    std::array<size_t, EnumValue(EntityType::Count)> sizes{};
+    ((sizes[EnumValue(T::cEntityType)] = sizeof(T)), ...);
+    return sizes;
+}
+
+static constexpr auto ENTITY_SIZES = GetEntitySizes<
+    Vehicle, Guest, Staff, Litter, SteamParticle, MoneyEffect, VehicleCrashParticle, ExplosionCloud, CrashSplashParticle,
+    ExplosionFlare, JumpingFountain, Balloon, Duck>();
+
+static std::array<EntityPool, EnumValue(EntityType::Count)> CreateEntityPools()
+{
+    std::array<EntityPool, EnumValue(EntityType::Count)> pools;
+    for (size_t i = 0; i < pools.size(); i++)
+    {
+        pools[i] = EntityPool(ENTITY_SIZES[i]);
+    }
+    return pools;
+}
+
+// Ids that are not in use point to their entry in _nullEntities so looking up any id always yields a valid entity.
+static EntityBase _nullEntities[MAX_ENTITIES];
+static std::array<EntityPool, EnumValue(EntityType::Count)> _entityPools = CreateEntityPools();
+
+static std::array<EntityBase*, MAX_ENTITIES> CreateNullEntityPointers()
+{
+    std::array<EntityBase*, MAX_ENTITIES> pointers;
+    for (EntityId::UnderlyingType i = 0; i < MAX_ENTITIES; i++)
+    {
+        _nullEntities[i].Type = EntityType::Null;
+        _nullEntities[i].Id = EntityId::FromUnderlying(i);
+        pointers[i] = &_nullEntities[i];
+    }
+    return pointers;
+}
+
+static std::array<EntityBase*, MAX_ENTITIES> _entityPointers = CreateNullEntityPointers();
+static std::array<EntityIdSet, EnumValue(EntityType::Count)> gEntityLists;
+static EntityIdSet _freeIds;
 
 static bool _entityFlashingList[MAX_ENTITIES];
 
@@ -100,7 +203,7 @@ uint16_t GetEntityListCount(EntityType type)
 
 uint16_t GetNumFreeEntities()
 {
-    return static_cast<uint16_t>(_freeIdList.size());
+    return static_cast<uint16_t>(_freeIds.size());
 }
 
 std::string EntitiesChecksum::ToString() const
@@ -121,7 +224,7 @@ std::string EntitiesChecksum::ToString() const
 EntityBase* TryGetEntity(EntityId entityIndex)
 {
     const auto idx = entityIndex.ToUnderlying();
-    return idx >= MAX_ENTITIES ? nullptr : &_entities[idx].base;
+    return idx >= MAX_ENTITIES ? nullptr : _entityPointers[idx];
 }
 
 EntityBase* GetEntity(EntityId entityIndex)
@@ -143,24 +246,20 @@ static void ResetEntityLists()
 {
     for (auto& list : gEntityLists)
     {
-        list.clear();
+        list.Clear();
     }
 }
 
 static void ResetFreeIds()
 {
-    _freeIdList.clear();
-    _freeIdList.resize(MAX_ENTITIES);
-
-    // List needs to be back to front to simplify removing
-    auto nextId = 0;
-    std::for_each(std::rbegin(_freeIdList), std::rend(_freeIdList), [&](auto& elem) {
-        elem = EntityId::FromUnderlying(nextId);
-        nextId++;
-    });
+    _freeIds.Clear();
+    for (EntityId::UnderlyingType i = 0; i < MAX_ENTITIES; i++)
+    {
+        _freeIds.Insert(EntityId::FromUnderlying(i));
+    }
 }
 
-const std::list<EntityId>& GetEntityList(const EntityType id)
+const EntityIdSet& GetEntityList(const EntityType id)
 {
     return gEntityLists[EnumValue(id)];
 }
@@ -184,24 +283,25 @@ void ResetAllEntities()
         FreeEntity(*spr);
     }
 
-    std::fill(std::begin(_entities), std::end(_entities), Entity());
+    for (auto& pool : _entityPools)
+    {
+        pool.Reset();
+    }
     OpenRCT2::RideUse::GetHistory().Clear();
     OpenRCT2::RideUse::GetTypeHistory().Clear();
     for (int32_t i = 0; i < MAX_ENTITIES; ++i)
     {
-        auto* spr = GetEntity(EntityId::FromUnderlying(i));
-        if (spr == nullptr)
-        {
-            continue;
-        }
-        spr->Type = EntityType::Null;
-        spr->Id = EntityId::FromUnderlying(i);
+        _nullEntities[i] = EntityBase();
+        _nullEntities[i].Type = EntityType::Null;
+        _nullEntities[i].Id = EntityId::FromUnderlying(i);
+        _entityPointers[i] = &_nullEntities[i];
 
         _entityFlashingList[i] = false;
     }
     ResetEntityLists();
     ResetFreeIds();
     ResetEntitySpatialIndices();
+    Litter::ResetAgedCount();
 }
 
 static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc);
@@ -262,14 +362,13 @@ EntitiesChecksum GetAllEntitiesChecksum()
 
 #endif // DISABLE_NETWORK
 
-static void EntityReset(EntityBase* entity)
+static void EntityReset(EntityBase* entity, size_t size)
 {
     // Need to retain how the sprite is linked in lists
     auto entityIndex = entity->Id;
     _entityFlashingList[entityIndex.ToUnderlying()] = false;
 
-    Entity* spr = reinterpret_cast<Entity*>(entity);
-    *spr = Entity();
+    std::memset(static_cast<void*>(entity), 0, size);
 
     entity->Id = entityIndex;
     entity->Type = EntityType::Null;
@@ -278,25 +377,19 @@ static void EntityReset(EntityBase* entity)
 static constexpr uint16_t MAX_MISC_SPRITES = 300;
 static void AddToEntityList(EntityBase* entity)
 {
-    auto& list = gEntityLists[EnumValue(entity->Type)];
-    // Entity list must be in sprite_index order to prevent desync issues
-    list.insert(std::lower_bound(std::begin(list), std::end(list), entity->Id), entity->Id);
+    // Entity lists are iterated in sprite_index order to prevent desync issues
+    gEntityLists[EnumValue(entity->Type)].Insert(entity->Id);
 }
 
 static void AddToFreeList(EntityId index)
 {
-    // Free list must be in reverse sprite_index order to prevent desync issues
-    _freeIdList.insert(std::upper_bound(std::rbegin(_freeIdList), std::rend(_freeIdList), index).base(), index);
+    // New entities always take the lowest free sprite_index to prevent desync issues
+    _freeIds.Insert(index);
 }
 
 static void RemoveFromEntityList(EntityBase* entity)
 {
-    auto& list = gEntityLists[EnumValue(entity->Type)];
-    auto ptr = BinaryFind(std::begin(list), std::end(list), entity->Id);
-    if (ptr != std::end(list))
-    {
-        list.erase(ptr);
-    }
+    gEntityLists[EnumValue(entity->Type)].Erase(entity->Id);
 }
 
 uint16_t GetMiscEntityCount()
@@ -311,14 +404,24 @@ uint16_t GetMiscEntityCount()
     return count;
 }
 
-static void PrepareNewEntity(EntityBase* base, const EntityType type)
+static EntityBase* PrepareNewEntity(const EntityId id, const EntityType type)
 {
+    const auto index = id.ToUnderlying();
+    auto& pool = _entityPools[EnumValue(type)];
+    auto* base = pool.Allocate(id);
+    _entityPointers[index] = base;
+
     // Need to reset all sprite data, as the uninitialised values
     // may contain garbage and cause a desync later on.
-    EntityReset(base);
+    base->Id = id;
+    EntityReset(base, pool.GetSlotSize());
 
     base->Type = type;
     AddToEntityList(base);
+    if (type == EntityType::Litter)
+    {
+        Litter::OnCreated(id);
+    }
 
     base->x = LOCATION_NULL;
     base->y = LOCATION_NULL;
@@ -329,11 +432,12 @@ static void PrepareNewEntity(EntityBase* base, const EntityType type)
     base->SpriteData.SpriteRect = {};
 
     EntitySpatialInsert(base, { LOCATION_NULL, 0 });
+    return base;
 }
 
 EntityBase* CreateEntity(EntityType type)
 {
-    if (_freeIdList.size() == 0)
+    if (_freeIds.empty())
     {
         // No free sprites.
         return nullptr;
@@ -345,42 +449,26 @@ EntityBase* CreateEntity(EntityType type)
         // free it will fail to keep slots for more relevant sprites.
         // Also there can't be more than MAX_MISC_SPRITES sprites in this list.
         uint16_t miscSlotsRemaining = MAX_MISC_SPRITES - GetMiscEntityCount();
-        if (miscSlotsRemaining >= _freeIdList.size())
+        if (miscSlotsRemaining >= _freeIds.size())
         {
             return nullptr;
         }
     }
 
-    auto* entity = GetEntity(_freeIdList.back());
-    if (entity == nullptr)
-    {
-        return nullptr;
-    }
-    _freeIdList.pop_back();
-
-    PrepareNewEntity(entity, type);
+    const auto id = _freeIds.Front();
+    _freeIds.Erase(id);
 
-    return entity;
+    return PrepareNewEntity(id, type);
 }
 
 EntityBase* CreateEntityAt(const EntityId index, const EntityType type)
 {
-    auto id = BinaryFind(std::rbegin(_freeIdList), std::rend(_freeIdList), index);
-    if (id == std::rend(_freeIdList))
+    if (index.ToUnderlying() >= MAX_ENTITIES || !_freeIds.Erase(index))
     {
         return nullptr;
     }
 
-    auto* entity = GetEntity(index);
-    if (entity == nullptr)
-    {
-        return nullptr;
-    }
-
-    _freeIdList.erase(std::next(id).base());
-
-    PrepareNewEntity(entity, type);
-    return entity;
+    return PrepareNewEntity(index, type);
 }
 
 template<typename T> void MiscUpdateAllType()
@@ -502,6 +590,10 @@ static void FreeEntity(EntityBase& entity)
         OpenRCT2::RideUse::GetHistory().RemoveHandle(guest->Id);
         OpenRCT2::RideUse::GetTypeHistory().RemoveHandle(guest->Id);
     }
+    else if (auto* litter = entity.As<Litter>(); litter != nullptr)
+    {
+        Litter::OnRemoved(*litter);
+    }
 }
 
 /**
@@ -517,7 +609,13 @@ void EntityRemove(EntityBase* entity)
     AddToFreeList(entity->Id);
 
     EntitySpatialRemove(entity);
-    EntityReset(entity);
+
+    // The slot stays reserved for this id in the pool of its type. Pointers that are still held to the removed entity
+    // see it as a null entity until the id is used for the same type again.
+    const auto index = entity->Id.ToUnderlying();
+    auto& pool = _entityPools[EnumValue(entity->Type)];
+    _entityPointers[index] = &_nullEntities[index];
+    EntityReset(entity, pool.GetSlotSize());
 }
 
 /**
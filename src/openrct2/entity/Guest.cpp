@@ -2992,15 +2992,14 @@ static PeepThoughtType PeepAssessSurroundings(int16_t centre_x, int16_t centre_y
         }
     }
 
-    for (auto litter : EntityList<Litter>())
-    {
-        int16_t dist_x = abs(litter->x - centre_x);
-        int16_t dist_y = abs(litter->y - centre_y);
+    ForEachEntityInRadius<Litter>({ centre_x, centre_y }, 160, [&](const Litter& litter) {
+        int16_t dist_x = abs(litter.x - centre_x);
+        int16_t dist_y = abs(litter.y - centre_y);
         if (std::max(dist_x, dist_y) <= 160)
         {
             num_rubbish++;
         }
-    }
+    });
 
     if (num_fountains >= 5 && num_rubbish < 20)
         return PeepThoughtType::Fountains;
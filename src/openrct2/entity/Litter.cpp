@@ -11,6 +11,8 @@
 #include "EntityList.h"
 #include "EntityRegistry.h"
 
+#include <array>
+
 template<> bool EntityBase::Is<Litter>() const
 {
     return Type == EntityType::Litter;
@@ -140,6 +142,141 @@ uint32_t Litter::GetAge() const
     return gCurrentTicks - creationTick;
 }
 
+// Litter that is younger than Litter::AgedTicks is counted per creation tick, the slots are reused as the ticks pass.
+static constexpr uint32_t YoungLitterRingSize = 8192;
+static_assert(YoungLitterRingSize >= Litter::AgedTicks);
+static_assert((YoungLitterRingSize & (YoungLitterRingSize - 1)) == 0, "Must divide the tick range evenly");
+
+static std::array<uint16_t, YoungLitterRingSize> _youngLitterPerTick;
+static uint32_t _youngLitterCount;
+// All creation ticks up to this one are no longer in the ring.
+static uint32_t _youngLitterExpiredTick;
+static bool _youngLitterValid;
+// Litter that has been created since the last query, its creation tick is not necessarily set at creation time.
+static EntityIdSet _newLitter;
+
+static bool IsYoungLitterTick(uint32_t tick)
+{
+    return tick - _youngLitterExpiredTick - 1 < Litter::AgedTicks;
+}
+
+static void AddYoungLitter(const Litter& litter)
+{
+    if (IsYoungLitterTick(litter.creationTick))
+    {
+        _youngLitterPerTick[litter.creationTick % YoungLitterRingSize]++;
+        _youngLitterCount++;
+    }
+}
+
+static void RebuildYoungLitter()
+{
+    _youngLitterPerTick.fill(0);
+    _youngLitterCount = 0;
+    _youngLitterExpiredTick = gCurrentTicks - Litter::AgedTicks;
+    for (auto* litter : EntityList<Litter>())
+    {
+        AddYoungLitter(*litter);
+    }
+    _newLitter.Clear();
+    _youngLitterValid = true;
+}
+
+static void ExpireYoungLitter()
+{
+    const auto expireTick = gCurrentTicks - Litter::AgedTicks;
+    const auto numTicks = expireTick - _youngLitterExpiredTick;
+    if (numTicks >= 0x80000000)
+    {
+        // The tick counter went backwards.
+        RebuildYoungLitter();
+        return;
+    }
+
+    if (numTicks >= Litter::AgedTicks)
+    {
+        _youngLitterPerTick.fill(0);
+        _youngLitterCount = 0;
+    }
+    else
+    {
+        for (uint32_t i = 1; i <= numTicks; i++)
+        {
+            auto& count = _youngLitterPerTick[(_youngLitterExpiredTick + i) % YoungLitterRingSize];
+            _youngLitterCount -= count;
+            count = 0;
+        }
+    }
+    _youngLitterExpiredTick = expireTick;
+}
+
+uint32_t Litter::GetAgedCount()
+{
+    if (!_youngLitterValid)
+    {
+        RebuildYoungLitter();
+    }
+    else
+    {
+        ExpireYoungLitter();
+        for (auto id : _newLitter)
+        {
+            auto* litter = GetEntity<Litter>(id);
+            if (litter != nullptr)
+            {
+                AddYoungLitter(*litter);
+            }
+        }
+        _newLitter.Clear();
+    }
+
+    const auto agedCount = GetEntityListCount(EntityType::Litter) - _youngLitterCount;
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    // Cross-check against counting every litter entity.
+    uint32_t expectedCount = 0;
+    for (auto* litter : EntityList<Litter>())
+    {
+        if (litter->GetAge() >= Litter::AgedTicks)
+        {
+            expectedCount++;
+        }
+    }
+    if (agedCount != expectedCount)
+    {
+        LOG_ERROR("Aged litter count is %u, expected %u. Rebuilding.", agedCount, expectedCount);
+        RebuildYoungLitter();
+        return expectedCount;
+    }
+#endif
+    return agedCount;
+}
+
+void Litter::OnCreated(EntityId id)
+{
+    if (_youngLitterValid)
+    {
+        _newLitter.Insert(id);
+    }
+}
+
+void Litter::OnRemoved(const Litter& litter)
+{
+    if (!_youngLitterValid || _newLitter.Erase(litter.Id))
+        return;
+
+    if (IsYoungLitterTick(litter.creationTick))
+    {
+        _youngLitterPerTick[litter.creationTick % YoungLitterRingSize]--;
+        _youngLitterCount--;
+    }
+}
+
+void Litter::ResetAgedCount()
+{
+    _youngLitterValid = false;
+    _newLitter.Clear();
+}
+
 void Litter::Serialise(DataSerialiser& stream)
 {
     EntityBase::Serialise(stream);
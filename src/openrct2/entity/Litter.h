@@ -37,8 +37,21 @@ struct Litter : EntityBase
     static constexpr auto cEntityType = EntityType::Litter;
     Type SubType;
     uint32_t creationTick;
+    // Litter starts to lower the park rating once it has been lying around for this many ticks.
+    static constexpr uint32_t AgedTicks = 7680;
+
     static void Create(const CoordsXYZD& litterPos, Type type);
     static void RemoveAt(const CoordsXYZ& litterPos);
+
+    /**
+     * Returns the number of litter entities that are at least AgedTicks old. The count is kept up to date as litter
+     * is created and removed instead of checking the age of every litter entity.
+     */
+    static uint32_t GetAgedCount();
+    static void OnCreated(EntityId id);
+    static void OnRemoved(const Litter& litter);
+    static void ResetAgedCount();
+
     void Serialise(DataSerialiser& stream);
     StringId GetName() const;
     uint32_t GetAge() const;
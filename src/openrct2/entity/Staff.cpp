@@ -332,20 +332,11 @@ bool Staff::HasPatrolArea() const
  */
 Direction Staff::HandymanDirectionToNearestLitter() const
 {
-    uint16_t nearestLitterDist = 0xFFFF;
-    Litter* nearestLitter = nullptr;
-    for (auto litter : EntityList<Litter>())
-    {
-        uint16_t distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
-
-        if (distance < nearestLitterDist)
-        {
-            nearestLitterDist = distance;
-            nearestLitter = litter;
-        }
-    }
-
-    if (nearestLitterDist > MAX_LITTER_DISTANCE)
+    const auto litterDistance = [this](const Litter& litter) {
+        return abs(litter.x - x) + abs(litter.y - y) + abs(litter.z - z) * 4;
+    };
+    auto* nearestLitter = GetNearestEntity<Litter>({ x, y }, MAX_LITTER_DISTANCE, litterDistance);
+    if (nearestLitter == nullptr || litterDistance(*nearestLitter) > MAX_LITTER_DISTANCE)
     {
         return INVALID_DIRECTION;
     }
@@ -50,6 +50,7 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../paint/PaintCapture.h"
 #include "../platform/Platform.h"
 #include "../profiling/Profiling.h"
 #include "../ride/Ride.h"
@@ -64,6 +65,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cinttypes>
 #include <cmath>
 #include <cstdarg>
 #include <cstdlib>
@@ -1924,6 +1926,93 @@ static int32_t ConsoleCommandProfilerStop(
     return 0;
 }
 
+static int32_t ConsoleCommandProfilerTraceStart(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() < 1)
+    {
+        console.WriteLineError("Missing argument: <file path>");
+        return 1;
+    }
+
+    const auto& traceFilePath = argv[0];
+    if (!OpenRCT2::Profiling::StartTrace(traceFilePath))
+    {
+        console.WriteFormatLine("Unable to open trace file %s", traceFilePath.c_str());
+        return 1;
+    }
+
+    console.WriteFormatLine("Started profiler trace: \"%s\"", traceFilePath.c_str());
+    return 0;
+}
+
+static int32_t ConsoleCommandProfilerTraceStop(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    if (!OpenRCT2::Profiling::IsTracing())
+    {
+        console.WriteLineError("Profiler trace is not running.");
+        return 1;
+    }
+
+    OpenRCT2::Profiling::StopTrace();
+    console.WriteLine("Stopped profiler trace");
+    return 0;
+}
+
+static int32_t ConsoleCommandProfilerCounters(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    const auto counters = OpenRCT2::Profiling::GetCounters();
+    if (counters.empty())
+    {
+        console.WriteLine("No counters have been recorded, start the profiler first.");
+        return 0;
+    }
+
+    for (const auto& counter : counters)
+    {
+        console.WriteFormatLine(
+            "%s: %" PRId64 " (min %" PRId64 ", max %" PRId64 ")", counter.Name.c_str(), counter.Value, counter.MinValue,
+            counter.MaxValue);
+    }
+    return 0;
+}
+
+static int32_t ConsoleCommandPaintCapture(InteractiveConsole& console, const arguments_t& argv)
+{
+    const auto* viewport = WindowGetViewport(WindowGetMain());
+    if (viewport == nullptr)
+    {
+        console.WriteLineError("There is no main viewport to capture.");
+        return 1;
+    }
+
+    std::string name = argv.empty() ? "paint" : argv[0];
+    if (!String::EndsWith(name, ".json", true))
+    {
+        name += ".json";
+    }
+    auto outPath = OpenRCT2::GetContext()->GetPlatformEnvironment()->GetDirectoryPath(
+        OpenRCT2::DIRBASE::USER, OpenRCT2::DIRID::REPLAY);
+    name = Path::Combine(outPath, name);
+
+    try
+    {
+        auto capture = PaintCaptureCreate(*viewport, GetCurrentRotation());
+        if (!PaintCaptureSave(capture, name))
+        {
+            console.WriteLineError("Unable to save the park for the paint capture.");
+            return 1;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        console.WriteLineError(e.what());
+        return 1;
+    }
+
+    console.WriteFormatLine("Saved paint capture: \"%s\"", name.c_str());
+    return 0;
+}
+
 using console_command_func = int32_t (*)(InteractiveConsole& console, const arguments_t& argv);
 struct ConsoleCommand
 {
@@ -2035,6 +2124,14 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "profiler_stop", ConsoleCommandProfilerStop, "Stops the profiler.", "profiler_stop [<output file>]" },
     { "profiler_exportcsv", ConsoleCommandProfilerExportCSV, "Exports the current profiler data.",
       "profiler_exportcsv <output file>" },
+    { "profiler_trace_start", ConsoleCommandProfilerTraceStart,
+      "Starts the profiler and streams a Chrome trace of all profiled functions to a file.",
+      "profiler_trace_start <output file>" },
+    { "profiler_trace_stop", ConsoleCommandProfilerTraceStop, "Stops writing the profiler trace.", "profiler_trace_stop" },
+    { "profiler_counters", ConsoleCommandProfilerCounters, "Lists the counters recorded by the profiler.", "profiler_counters" },
+    { "paint_capture", ConsoleCommandPaintCapture,
+      "Saves the park and the main viewport to the replay directory, for use with the benchpaint command.",
+      "paint_capture [name]" },
 };
 
 static int32_t ConsoleCommandWindows(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
@@ -20,6 +20,7 @@
 #include "../core/Console.hpp"
 #include "../core/File.h"
 #include "../core/Imaging.h"
+#include "../core/JobPool.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
@@ -35,12 +36,15 @@
 #include "Viewport.h"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <chrono>
 #include <cstdlib>
+#include <exception>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 using namespace std::literals::string_literals;
 using namespace OpenRCT2;
@@ -52,6 +56,9 @@ extern uint8_t gClipHeight;
 
 uint8_t gScreenshotCountdown = 0;
 
+// Screenshots of whole views are rendered and written in strips of about this many pixels at a time.
+static constexpr uint32_t ScreenshotStripSize = 16 * 1024 * 1024;
+
 static bool WriteDpiToFile(std::string_view path, const DrawPixelInfo& dpi, const GamePalette& palette)
 {
     auto const pixels8 = dpi.bits;
@@ -250,34 +257,6 @@ static int32_t GetTallestVisibleTileTop(
     return minViewY - 64;
 }
 
-static DrawPixelInfo CreateDPI(const Viewport& viewport)
-{
-    DrawPixelInfo dpi;
-    dpi.width = viewport.width;
-    dpi.height = viewport.height;
-    dpi.bits = new (std::nothrow) uint8_t[dpi.width * dpi.height];
-    if (dpi.bits == nullptr)
-    {
-        throw std::runtime_error("Giant screenshot failed, unable to allocate memory for image.");
-    }
-
-    if (viewport.flags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND)
-    {
-        std::memset(dpi.bits, PALETTE_INDEX_0, static_cast<size_t>(dpi.width) * dpi.height);
-    }
-
-    return dpi;
-}
-
-static void ReleaseDPI(DrawPixelInfo& dpi)
-{
-    if (dpi.bits != nullptr)
-        delete[] dpi.bits;
-    dpi.bits = nullptr;
-    dpi.width = 0;
-    dpi.height = 0;
-}
-
 static Viewport GetGiantViewport(int32_t rotation, ZoomLevel zoom)
 {
     // Get the tile coordinates of each corner
@@ -325,24 +304,68 @@ static Viewport GetGiantViewport(int32_t rotation, ZoomLevel zoom)
     return viewport;
 }
 
-static void RenderViewport(IDrawingEngine* drawingEngine, const Viewport& viewport, DrawPixelInfo& dpi)
+/**
+ * Renders the viewport in horizontal strips and writes each strip to the PNG file as soon as it is finished, while
+ * the next strip is rendered. Only two strips are ever held in memory, however large the viewport is.
+ */
+static void WriteViewportToFile(std::string_view path, const Viewport& viewport, const GamePalette& palette)
 {
     // Ensure sprites appear regardless of rotation
     ResetAllSpriteQuadrantPlacements();
 
-    std::unique_ptr<X8DrawingEngine> tempDrawingEngine;
-    if (drawingEngine == nullptr)
+    X8DrawingEngine drawingEngine(GetContext()->GetUiContext());
+
+    const auto width = static_cast<uint32_t>(viewport.width);
+    const auto height = static_cast<uint32_t>(viewport.height);
+    const auto stripHeight = std::clamp<uint32_t>(ScreenshotStripSize / std::max(width, 1u), 1, std::max(height, 1u));
+
+    Imaging::PngWriter writer(path, width, height, palette);
+    std::array<std::vector<uint8_t>, 2> strips;
+    std::exception_ptr writeError;
+
+    JobPool::TaskGroup writeTasks(JobPool::GetShared());
+    size_t stripIndex = 0;
+    for (uint32_t top = 0; top < height; top += stripHeight)
     {
-        tempDrawingEngine = std::make_unique<X8DrawingEngine>(GetContext()->GetUiContext());
-        drawingEngine = tempDrawingEngine.get();
+        const auto numRows = std::min(stripHeight, height - top);
+        auto& strip = strips[stripIndex];
+        stripIndex ^= 1;
+
+        // A strip is only reused once the strip rendered after it has been submitted, by then it has been written.
+        strip.assign(static_cast<size_t>(width) * numRows, PALETTE_INDEX_0);
+
+        DrawPixelInfo dpi{};
+        dpi.DrawingEngine = &drawingEngine;
+        dpi.bits = strip.data();
+        dpi.y = static_cast<int32_t>(top);
+        dpi.width = static_cast<int32_t>(width);
+        dpi.height = static_cast<int32_t>(numRows);
+        ViewportRender(
+            dpi, &viewport, { { 0, static_cast<int32_t>(top) }, { viewport.width, static_cast<int32_t>(top + numRows) } });
+
+        writeTasks.Wait();
+        if (writeError != nullptr)
+            break;
+        writeTasks.Run([&writer, &strip, &writeError, numRows, width]() {
+            try
+            {
+                writer.WriteRows(strip.data(), numRows, width);
+            }
+            catch (...)
+            {
+                writeError = std::current_exception();
+            }
+        });
     }
-    dpi.DrawingEngine = drawingEngine;
-    ViewportRender(dpi, &viewport, { { 0, 0 }, { viewport.width, viewport.height } });
+    writeTasks.Wait();
+
+    if (writeError != nullptr)
+        std::rethrow_exception(writeError);
+    writer.Finish();
 }
 
 void ScreenshotGiant()
 {
-    DrawPixelInfo dpi{};
     try
     {
         auto path = ScreenshotGetNextPath();
@@ -370,10 +393,7 @@ void ScreenshotGiant()
             viewport.flags |= VIEWPORT_FLAG_TRANSPARENT_BACKGROUND;
         }
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(path.value(), dpi, gPalette);
+        WriteViewportToFile(path.value(), viewport, gPalette);
 
         // Show user that screenshot saved successfully
         const auto filename = Path::GetFileName(path.value());
@@ -387,8 +407,6 @@ void ScreenshotGiant()
         LOG_ERROR("%s", e.what());
         ContextShowError(STR_SCREENSHOT_FAILED, STR_NONE, {});
     }
-
-    ReleaseDPI(dpi);
 }
 
 static void ApplyOptions(const ScreenshotOptions* options, Viewport& viewport)
@@ -461,7 +479,6 @@ int32_t CommandLineForScreenshot(const char** argv, int32_t argc, ScreenshotOpti
     }
 
     int32_t exitCode = 1;
-    DrawPixelInfo dpi;
     try
     {
         bool customLocation = false;
@@ -563,17 +580,13 @@ int32_t CommandLineForScreenshot(const char** argv, int32_t argc, ScreenshotOpti
 
         ApplyOptions(options, viewport);
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(outputPath, dpi, gPalette);
+        WriteViewportToFile(outputPath, viewport, gPalette);
     }
     catch (const std::exception& e)
     {
         std::printf("%s\n", e.what());
         exitCode = -1;
     }
-    ReleaseDPI(dpi);
 
     DrawingEngineDispose();
 
@@ -660,10 +673,7 @@ void CaptureImage(const CaptureOptions& options)
     }
 
     auto outputPath = ResolveFilenameForCapture(options.Filename);
-    auto dpi = CreateDPI(viewport);
-    RenderViewport(nullptr, viewport, dpi);
-    WriteDpiToFile(outputPath, dpi, gPalette);
-    ReleaseDPI(dpi);
+    WriteViewportToFile(outputPath, viewport, gPalette);
 
     gCurrentRotation = backupRotation;
 }
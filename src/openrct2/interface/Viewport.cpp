@@ -61,9 +61,21 @@ uint8_t gShowConstructionRightsRefCount;
 static std::list<Viewport> _viewports;
 Viewport* g_music_tracking_viewport;
 
-static std::unique_ptr<JobPool> _paintJobs;
 static std::vector<PaintSession*> _paintColumns;
 
+// A range of the tile rows of a column, generated in its own session and merged into the column session afterwards.
+struct PaintColumnPart
+{
+    PaintSession* Session;
+    uint32_t FirstRow;
+    uint32_t NumRows;
+};
+static std::vector<PaintColumnPart> _paintColumnParts;
+static std::vector<size_t> _paintColumnFirstPart;
+
+// Fewest tile rows worth generating in a separate session.
+static constexpr uint32_t MinPaintColumnPartRows = 32;
+
 ScreenCoordsXY gSavedView;
 ZoomLevel gSavedViewZoom;
 uint8_t gSavedViewRotation;
@@ -853,6 +865,43 @@ static void ViewportFillColumn(PaintSession& session)
     PaintSessionArrange(session);
 }
 
+static void ViewportFillColumnPart(const PaintColumnPart& part)
+{
+    PROFILED_FUNCTION();
+
+    PaintSessionGenerate(*part.Session, part.FirstRow, part.NumRows);
+}
+
+static void ViewportMergeColumn(size_t column)
+{
+    PROFILED_FUNCTION();
+
+    // The first part of a column is the column session itself.
+    auto& session = *_paintColumns[column];
+    const auto firstPart = _paintColumnFirstPart[column];
+    const auto endPart = column + 1 < _paintColumnFirstPart.size() ? _paintColumnFirstPart[column + 1]
+                                                                    : _paintColumnParts.size();
+    for (auto i = firstPart + 1; i < endPart; i++)
+    {
+        PaintSessionMerge(session, *_paintColumnParts[i].Session);
+    }
+    PaintSessionArrange(session);
+}
+
+/**
+ * Number of parts the tile rows of each column are split into. The columns are enough work on their own when
+ * there are plenty of them, a few tall columns would leave most of the job pool idle while they are generated.
+ */
+static uint32_t ViewportGetColumnParts(size_t numColumns, uint32_t numRows)
+{
+    const auto targetJobs = (JobPool::GetShared().GetWorkerCount() + 1) * 4;
+    if (numColumns == 0 || numColumns >= targetJobs)
+        return 1;
+
+    const auto numParts = static_cast<uint32_t>((targetJobs + numColumns - 1) / numColumns);
+    return std::clamp<uint32_t>(numParts, 1, std::max<uint32_t>(numRows / MinPaintColumnPartRows, 1));
+}
+
 static void ViewportPaintColumn(PaintSession& session)
 {
     PROFILED_FUNCTION();
@@ -937,14 +986,6 @@ void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi, const ScreenRec
     _paintColumns.clear();
 
     bool useMultithreading = gConfigGeneral.MultiThreading;
-    if (useMultithreading && _paintJobs == nullptr)
-    {
-        _paintJobs = std::make_unique<JobPool>();
-    }
-    else if (useMultithreading == false && _paintJobs != nullptr)
-    {
-        _paintJobs.reset();
-    }
 
     bool useParallelDrawing = false;
     if (useMultithreading && (dpi.DrawingEngine->GetFlags() & DEF_PARALLEL_DRAWING))
@@ -958,56 +999,67 @@ void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi, const ScreenRec
         PaintSession* session = PaintSessionAlloc(dpi1, viewFlags);
         _paintColumns.push_back(session);
 
-        DrawPixelInfo& dpi2 = session->DPI;
-        if (x >= dpi2.x)
-        {
-            auto leftPitch = x - dpi2.x;
-            dpi2.width -= leftPitch;
-            dpi2.bits += dpi2.zoom_level.ApplyInversedTo(leftPitch);
-            dpi2.pitch += dpi2.zoom_level.ApplyInversedTo(leftPitch);
-            dpi2.x = x;
-        }
+        ViewportClipToColumn(session->DPI, x);
 
-        auto paintRight = dpi2.x + dpi2.width;
-        if (paintRight >= x + 32)
+        if (!useMultithreading)
         {
-            auto rightPitch = paintRight - x - 32;
-            paintRight -= rightPitch;
-            dpi2.pitch += dpi2.zoom_level.ApplyInversedTo(rightPitch);
+            ViewportFillColumn(*session);
         }
-        dpi2.width = paintRight - dpi2.x;
+    }
 
-        if (useMultithreading)
+    if (useMultithreading)
+    {
+        const auto numRows = _paintColumns.empty() ? 0 : PaintSessionGetTileRowCount(*_paintColumns[0]);
+        const auto numParts = ViewportGetColumnParts(_paintColumns.size(), numRows);
+        if (numParts > 1)
         {
-            _paintJobs->AddTask([session]() -> void { ViewportFillColumn(*session); });
+            // Split the tile rows of each column over several sessions, generate them all at once and merge them in
+            // row order before sorting.
+            _paintColumnParts.clear();
+            _paintColumnFirstPart.clear();
+            for (auto* session : _paintColumns)
+            {
+                _paintColumnFirstPart.push_back(_paintColumnParts.size());
+                for (uint32_t part = 0; part < numParts; part++)
+                {
+                    const auto firstRow = numRows * part / numParts;
+                    const auto endRow = numRows * (part + 1) / numParts;
+                    auto* partSession = part == 0 ? session : PaintSessionAlloc(session->DPI, viewFlags);
+                    _paintColumnParts.push_back({ partSession, firstRow, endRow - firstRow });
+                }
+            }
+
+            JobPool::GetShared().ParallelFor(
+                _paintColumnParts.size(), [](size_t i) { ViewportFillColumnPart(_paintColumnParts[i]); });
+            JobPool::GetShared().ParallelFor(_paintColumns.size(), [](size_t i) { ViewportMergeColumn(i); });
+
+            for (const auto& part : _paintColumnParts)
+            {
+                if (part.FirstRow != 0)
+                {
+                    PaintSessionFree(part.Session);
+                }
+            }
+            _paintColumnParts.clear();
         }
         else
         {
-            ViewportFillColumn(*session);
+            JobPool::GetShared().ParallelFor(_paintColumns.size(), [](size_t i) { ViewportFillColumn(*_paintColumns[i]); });
         }
     }
 
-    if (useMultithreading)
+    // Paint columns.
+    if (useParallelDrawing)
     {
-        _paintJobs->Join();
+        JobPool::GetShared().ParallelFor(_paintColumns.size(), [](size_t i) { ViewportPaintColumn(*_paintColumns[i]); });
     }
-
-    // Paint columns.
-    for (auto* session : _paintColumns)
+    else
     {
-        if (useParallelDrawing)
-        {
-            _paintJobs->AddTask([session]() -> void { ViewportPaintColumn(*session); });
-        }
-        else
+        for (auto* session : _paintColumns)
         {
             ViewportPaintColumn(*session);
         }
     }
-    if (useParallelDrawing)
-    {
-        _paintJobs->Join();
-    }
 
     // Release resources.
     for (auto* session : _paintColumns)
@@ -1016,6 +1068,27 @@ void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi, const ScreenRec
     }
 }
 
+void ViewportClipToColumn(DrawPixelInfo& dpi, int32_t x)
+{
+    if (x >= dpi.x)
+    {
+        auto leftPitch = x - dpi.x;
+        dpi.width -= leftPitch;
+        dpi.bits += dpi.zoom_level.ApplyInversedTo(leftPitch);
+        dpi.pitch += dpi.zoom_level.ApplyInversedTo(leftPitch);
+        dpi.x = x;
+    }
+
+    auto paintRight = dpi.x + dpi.width;
+    if (paintRight >= x + 32)
+    {
+        auto rightPitch = paintRight - x - 32;
+        paintRight -= rightPitch;
+        dpi.pitch += dpi.zoom_level.ApplyInversedTo(rightPitch);
+    }
+    dpi.width = paintRight - dpi.x;
+}
+
 static void ViewportPaintWeatherGloom(DrawPixelInfo& dpi)
 {
     auto paletteId = ClimateGetWeatherGloomPaletteId(gClimateCurrent);
@@ -142,6 +142,11 @@ void ViewportUpdateSmartFollowVehicle(WindowBase* window);
 void ViewportRender(DrawPixelInfo& dpi, const Viewport* viewport, const ScreenRect& screenRect);
 void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi, const ScreenRect& screenRect);
 
+/**
+ * Narrows the dpi of a view down to the 32 pixel wide column starting at x, views are painted one column at a time.
+ */
+void ViewportClipToColumn(DrawPixelInfo& dpi, int32_t x);
+
 CoordsXYZ ViewportAdjustForMapHeight(const ScreenCoordsXY& startCoords);
 
 CoordsXY ViewportPosToMapPos(const ScreenCoordsXY& coords, int32_t z);
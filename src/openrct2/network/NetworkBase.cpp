@@ -43,7 +43,7 @@
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
 
-#define NETWORK_STREAM_VERSION "17"
+#define NETWORK_STREAM_VERSION "20"
 
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
@@ -67,6 +67,7 @@ static constexpr uint32_t MaxPacketsPerUpdate = 100;
 #    include "../config/Config.h"
 #    include "../core/Console.hpp"
 #    include "../core/FileStream.h"
+#    include "../core/JobPool.h"
 #    include "../core/MemoryStream.h"
 #    include "../core/Path.hpp"
 #    include "../core/String.hpp"
@@ -83,6 +84,7 @@ static constexpr uint32_t MaxPacketsPerUpdate = 100;
 #    include "NetworkConnection.h"
 #    include "NetworkGroup.h"
 #    include "NetworkKey.h"
+#    include "NetworkMapDelta.h"
 #    include "NetworkPacket.h"
 #    include "NetworkPlayer.h"
 #    include "NetworkServerAdvertiser.h"
@@ -91,7 +93,9 @@ static constexpr uint32_t MaxPacketsPerUpdate = 100;
 
 #    include <algorithm>
 #    include <array>
+#    include <atomic>
 #    include <cerrno>
+#    include <chrono>
 #    include <cmath>
 #    include <fstream>
 #    include <functional>
@@ -204,6 +208,7 @@ void NetworkBase::Close()
         _serverTickData.clear();
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
+        ReleaseMapDeltaBase();
 
 #    ifdef ENABLE_SCRIPTING
         auto& scriptEngine = GetContext().GetScriptEngine();
@@ -239,6 +244,9 @@ void NetworkBase::CloseConnection()
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        // Jobs still encoding a map keep their state alive on their own, there is no need to wait for them.
+        _pendingMaps.clear();
+        _socketPoller.reset();
         _listenSocket.reset();
         _advertiser.reset();
     }
@@ -373,6 +381,21 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
         return false;
     }
 
+    if (gOpenRCT2Headless)
+    {
+        try
+        {
+            _socketPoller = CreateSocketPoller();
+            _socketPoller->Add(*_listenSocket);
+        }
+        catch (const std::exception& ex)
+        {
+            // Fall back to checking every connection each update.
+            LOG_WARNING("Unable to wait on sockets: %s", ex.what());
+            _socketPoller.reset();
+        }
+    }
+
     ServerName = gConfigNetwork.ServerName;
     ServerDescription = gConfigNetwork.ServerDescription;
     ServerGreeting = gConfigNetwork.ServerGreeting;
@@ -509,21 +532,49 @@ void NetworkBase::Flush()
     }
 }
 
+bool NetworkBase::WaitForEvents(uint32_t timeoutMs)
+{
+    if (_socketPoller == nullptr || GetMode() != NETWORK_MODE_SERVER)
+    {
+        return false;
+    }
+
+    if (_socketPoller->Wait(timeoutMs))
+    {
+        Update();
+        Flush();
+    }
+    return true;
+}
+
 void NetworkBase::UpdateServer()
 {
+    if (_socketPoller != nullptr)
+    {
+        _socketPoller->Wait(0);
+    }
+
+    ServerProcessPendingMaps();
+
     for (auto& connection : client_connection_list)
     {
         // This can be called multiple times before the connection is removed.
-        if (!connection->IsValid())
-            continue;
-
-        if (!ProcessConnection(*connection))
+        if (connection->IsValid())
         {
+            const auto readable = _socketPoller == nullptr || _socketPoller->IsReady(*connection->Socket);
+            if (ProcessConnection(*connection, readable))
+            {
+                DecayCooldown(connection->Player);
+                continue;
+            }
             connection->Disconnect();
         }
-        else
+
+        // The socket is not read anymore, a hang up or pending data would wake the server up over and over again until
+        // the connection is removed at the end of the tick.
+        if (_socketPoller != nullptr)
         {
-            DecayCooldown(connection->Player);
+            _socketPoller->Remove(*connection->Socket);
         }
     }
 
@@ -539,10 +590,21 @@ void NetworkBase::UpdateServer()
         _advertiser->Update();
     }
 
-    std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
-    if (tcpSocket != nullptr)
+    if (_socketPoller == nullptr)
     {
-        AddClient(std::move(tcpSocket));
+        std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
+        if (tcpSocket != nullptr)
+        {
+            AddClient(std::move(tcpSocket));
+        }
+    }
+    else if (_socketPoller->IsReady(*_listenSocket))
+    {
+        // Several clients may have connected since the last wait.
+        while (auto tcpSocket = _listenSocket->Accept())
+        {
+            AddClient(std::move(tcpSocket));
+        }
     }
 }
 
@@ -726,6 +788,8 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromplayer, const char* text)
 
 void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd) const
 {
+    // Framed once, every queue shares the same buffer.
+    const auto framed = packet.Frame();
     for (auto& client_connection : client_connection_list)
     {
         if (gameCmd)
@@ -739,7 +803,7 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        client_connection->QueuePacket(packet, front);
+        client_connection->QueuePacket(framed, front);
     }
 }
 
@@ -1236,6 +1300,38 @@ void NetworkBase::Client_Send_MAPREQUEST(const std::vector<ObjectEntryDescriptor
             packet.WriteString(name);
         }
     }
+
+    // The server only sends the parts of the map that are not in the park we are in, which is the server's park from
+    // before when reconnecting. Only as many hashes as fit in the packet are sent, the server sends the data of the
+    // blocks after them. The park is saved here rather than kept after every load, and released once the map arrives.
+    ReleaseMapDeltaBase();
+    if (gScreenFlags == SCREEN_FLAGS_PLAYING)
+    {
+        try
+        {
+            auto ms = OpenRCT2::MemoryStream();
+            auto exporter = std::make_unique<ParkFileExporter>();
+            exporter->Compression = OrcaStream::COMPRESSION_NONE;
+            exporter->Export(ms);
+            _lastMap.resize(ms.GetLength());
+            std::memcpy(_lastMap.data(), ms.GetData(), _lastMap.size());
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to save the current map, requesting all of it: %s", e.what());
+            _lastMap.clear();
+        }
+    }
+    _lastMapBlocks = NetworkMapSplitBlocks(_lastMap.data(), _lastMap.size());
+    const auto sizeWithCount = packet.Data.size() + sizeof(uint32_t);
+    const auto spaceLeft = sizeWithCount < NetworkPacket::MaxDataSize ? NetworkPacket::MaxDataSize - sizeWithCount : 0;
+    const auto numHashes = std::min(_lastMapBlocks.size(), spaceLeft / sizeof(NetworkMapBlockHash));
+    _lastMapBlocks.resize(numHashes);
+    packet << static_cast<uint32_t>(numHashes);
+    for (const auto& block : _lastMapBlocks)
+    {
+        packet.Write(block.Hash.data(), block.Hash.size());
+    }
     _serverConnection->QueuePacket(std::move(packet));
 }
 
@@ -1364,6 +1460,8 @@ NetworkStats NetworkBase::GetStats() const
                 stats.bytesReceived[n] += connection->Stats.bytesReceived[n];
                 stats.bytesSent[n] += connection->Stats.bytesSent[n];
             }
+            stats.sendFlushes += connection->Stats.sendFlushes;
+            stats.sendSyscalls += connection->Stats.sendSyscalls;
         }
     }
     return stats;
@@ -1389,6 +1487,18 @@ void NetworkBase::ServerSendAuth(NetworkConnection& connection)
     }
 }
 
+struct NetworkBase::MapEncodeJob
+{
+    ParkFileExporter Exporter;
+    OpenRCT2::MemoryStream Park;
+    std::vector<NetworkMapBlockHash> BlockHashes;
+    int32_t Level{};
+    // Only read once Done is set.
+    std::vector<uint8_t> Data;
+    std::string Error;
+    std::atomic_bool Done{};
+};
+
 void NetworkBase::ServerSendMap(NetworkConnection* connection)
 {
     std::vector<const ObjectRepositoryItem*> objects;
@@ -1405,9 +1515,19 @@ void NetworkBase::ServerSendMap(NetworkConnection* connection)
         objects = objManager.GetPackableObjects();
     }
 
-    auto header = SaveForNetwork(objects);
-    if (header.empty())
+    // Only the small chunks are written between ticks, the map and entities are copied and written on a worker along
+    // with encoding the park against the client's last map.
+    auto job = std::make_shared<MapEncodeJob>();
+    job->Exporter.ExportObjectsList = objects;
+    job->Exporter.Compression = OrcaStream::COMPRESSION_NONE;
+    PrepareMapForSave();
+    try
     {
+        job->Exporter.BeginExport(job->Park);
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to serialise map: %s", e.what());
         if (connection != nullptr)
         {
             connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
@@ -1415,38 +1535,89 @@ void NetworkBase::ServerSendMap(NetworkConnection* connection)
         }
         return;
     }
-    size_t chunksize = CHUNK_SIZE;
-    for (size_t i = 0; i < header.size(); i += chunksize)
+
+    PendingMap pendingMap;
+    pendingMap.Job = job;
+    if (connection != nullptr)
     {
-        size_t datasize = std::min(chunksize, header.size() - i);
-        NetworkPacket packet(NetworkCommand::Map);
-        packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i);
-        packet.Write(&header[i], datasize);
-        if (connection != nullptr)
+        pendingMap.Connections.push_back(connection);
+        pendingMap.Joining = true;
+        job->BlockHashes = std::move(connection->MapBlockHashes);
+        connection->MapBlockHashes.clear();
+    }
+    else
+    {
+        for (auto& clientConnection : client_connection_list)
         {
-            connection->QueuePacket(std::move(packet));
+            pendingMap.Connections.push_back(clientConnection.get());
         }
-        else
+    }
+
+    // Everything sent to these clients from now on has to arrive after the map.
+    for (auto* pendingConnection : pendingMap.Connections)
+    {
+        pendingConnection->HoldPackets();
+    }
+
+    job->Level = gConfigGeneral.FastSaveCompression ? ZstdLevelFast : ZstdLevelDefault;
+    JobPool::GetShared().RunInBackground([job]() {
+        try
         {
-            SendPacketToClients(packet);
+            job->Exporter.FinishExport();
+            job->Data = NetworkMapEncodeDelta(
+                static_cast<const uint8_t*>(job->Park.GetData()), job->Park.GetLength(), job->BlockHashes, job->Level);
         }
-    }
+        catch (const std::exception& e)
+        {
+            job->Error = e.what();
+            job->Data.clear();
+        }
+        job->Park = {};
+        job->Done.store(true, std::memory_order_release);
+    });
+    _pendingMaps.push_back(std::move(pendingMap));
 }
 
-std::vector<uint8_t> NetworkBase::SaveForNetwork(const std::vector<const ObjectRepositoryItem*>& objects) const
+void NetworkBase::ServerProcessPendingMaps()
 {
-    std::vector<uint8_t> result;
-    auto ms = OpenRCT2::MemoryStream();
-    if (SaveMap(&ms, objects))
+    while (!_pendingMaps.empty())
     {
-        result.resize(ms.GetLength());
-        std::memcpy(result.data(), ms.GetData(), result.size());
-    }
-    else
-    {
-        LOG_WARNING("Failed to export map.");
+        auto& pendingMap = _pendingMaps.front();
+        if (!pendingMap.Job->Done.load(std::memory_order_acquire))
+        {
+            break;
+        }
+
+        auto& job = *pendingMap.Job;
+        if (!job.Error.empty())
+        {
+            LOG_WARNING("Failed to encode map: %s", job.Error.c_str());
+        }
+        auto header = std::move(job.Data);
+
+        std::vector<NetworkFramedPacketPtr> packets;
+        size_t chunksize = CHUNK_SIZE;
+        for (size_t i = 0; i < header.size(); i += chunksize)
+        {
+            size_t datasize = std::min(chunksize, header.size() - i);
+            NetworkPacket packet(NetworkCommand::Map);
+            packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i)
+                   << static_cast<uint8_t>(NetworkMapEncoding::Delta);
+            packet.Write(&header[i], datasize);
+            packets.push_back(packet.Frame());
+        }
+
+        for (auto* connection : pendingMap.Connections)
+        {
+            if (header.empty() && pendingMap.Joining)
+            {
+                connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+                connection->Disconnect();
+            }
+            connection->ReleasePackets(packets);
+        }
+        _pendingMaps.pop_front();
     }
-    return result;
 }
 
 void NetworkBase::Client_Send_CHAT(const char* text)
@@ -1671,12 +1842,12 @@ void NetworkBase::ServerSendEventPlayerDisconnected(const char* playerName, cons
     SendPacketToClients(packet);
 }
 
-bool NetworkBase::ProcessConnection(NetworkConnection& connection)
+bool NetworkBase::ProcessConnection(NetworkConnection& connection, bool readable)
 {
-    NetworkReadPacket packetStatus;
+    NetworkReadPacket packetStatus = NetworkReadPacket::NoData;
 
     uint32_t countProcessed = 0;
-    do
+    while (readable)
     {
         countProcessed++;
         packetStatus = connection.ReadPacket();
@@ -1704,7 +1875,11 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
                 // could not read anything from socket
                 break;
         }
-    } while (packetStatus == NetworkReadPacket::Success && countProcessed < MaxPacketsPerUpdate);
+        if (packetStatus != NetworkReadPacket::Success || countProcessed >= MaxPacketsPerUpdate)
+        {
+            break;
+        }
+    }
 
     if (!connection.ReceivedPacketRecently())
     {
@@ -1958,6 +2133,17 @@ void NetworkBase::ProcessDisconnectedClients()
         ServerClientDisconnected(connection);
         RemovePlayer(connection);
 
+        if (_socketPoller != nullptr)
+        {
+            _socketPoller->Remove(*connection->Socket);
+        }
+        for (auto& pendingMap : _pendingMaps)
+        {
+            auto& pendingConnections = pendingMap.Connections;
+            pendingConnections.erase(
+                std::remove(pendingConnections.begin(), pendingConnections.end(), connection.get()),
+                pendingConnections.end());
+        }
         it = client_connection_list.erase(it);
     }
 }
@@ -1972,6 +2158,10 @@ void NetworkBase::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     // Store connection
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
+    if (_socketPoller != nullptr)
+    {
+        _socketPoller->Add(*connection->Socket);
+    }
 
     client_connection_list.push_back(std::move(connection));
 }
@@ -2560,6 +2750,20 @@ void NetworkBase::ServerHandleMapRequest(NetworkConnection& connection, NetworkP
         }
     }
 
+    uint32_t numBlockHashes{};
+    packet >> numBlockHashes;
+    connection.MapBlockHashes.clear();
+    for (uint32_t i = 0; i < numBlockHashes; i++)
+    {
+        const auto* hash = packet.Read(sizeof(NetworkMapBlockHash));
+        if (hash == nullptr)
+        {
+            break;
+        }
+        auto& blockHash = connection.MapBlockHashes.emplace_back();
+        std::memcpy(blockHash.data(), hash, blockHash.size());
+    }
+
     auto player_name = connection.Player->Name.c_str();
     ServerSendMap(&connection);
     ServerSendEventPlayerJoined(player_name);
@@ -2696,7 +2900,8 @@ void NetworkBase::ServerHandleAuth(NetworkConnection& connection, NetworkPacket&
 void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t size, offset;
-    packet >> size >> offset;
+    uint8_t encoding;
+    packet >> size >> offset >> encoding;
     int32_t chunksize = static_cast<int32_t>(packet.Header.Size - packet.BytesRead);
     if (chunksize <= 0)
     {
@@ -2741,8 +2946,27 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
         bool has_to_free = false;
         uint8_t* data = &chunk_buffer[0];
         size_t data_size = size;
+
+        bool decoded = true;
+        std::vector<uint8_t> map;
+        if (encoding == EnumValue(NetworkMapEncoding::Delta))
+        {
+            try
+            {
+                map = NetworkMapDecodeDelta(data, data_size, _lastMap, _lastMapBlocks);
+                data = map.data();
+                data_size = map.size();
+            }
+            catch (const std::exception& e)
+            {
+                Console::Error::WriteLine("Unable to read map from server: %s", e.what());
+                decoded = false;
+            }
+        }
+        ReleaseMapDeltaBase();
+
         auto ms = MemoryStream(data, data_size);
-        if (LoadMap(&ms))
+        if (decoded && LoadMap(&ms))
         {
             GameLoadInit();
             GameLoadScripts();
@@ -2777,6 +3001,14 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
     }
 }
 
+void NetworkBase::ReleaseMapDeltaBase()
+{
+    _lastMap.clear();
+    _lastMap.shrink_to_fit();
+    _lastMapBlocks.clear();
+    _lastMapBlocks.shrink_to_fit();
+}
+
 bool NetworkBase::LoadMap(IStream* stream)
 {
     bool result = false;
@@ -2802,24 +3034,6 @@ bool NetworkBase::LoadMap(IStream* stream)
     return result;
 }
 
-bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const
-{
-    bool result = false;
-    PrepareMapForSave();
-    try
-    {
-        auto exporter = std::make_unique<ParkFileExporter>();
-        exporter->ExportObjectsList = objects;
-        exporter->Export(*stream);
-        result = true;
-    }
-    catch (const std::exception& e)
-    {
-        Console::Error::WriteLine("Unable to serialise map: %s", e.what());
-    }
-    return result;
-}
-
 void NetworkBase::Client_Handle_CHAT([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
     auto text = packet.ReadString();
@@ -3235,6 +3449,11 @@ void NetworkFlush()
     OpenRCT2::GetContext()->GetNetwork().Flush();
 }
 
+bool NetworkWaitForEvents(uint32_t timeoutMs)
+{
+    return OpenRCT2::GetContext()->GetNetwork().WaitForEvents(timeoutMs);
+}
+
 int32_t NetworkGetMode()
 {
     return OpenRCT2::GetContext()->GetNetwork().GetMode();
@@ -4019,6 +4238,10 @@ uint32_t NetworkGetServerTick()
 void NetworkFlush()
 {
 }
+bool NetworkWaitForEvents(uint32_t timeoutMs)
+{
+    return false;
+}
 void NetworkSendTick()
 {
 }
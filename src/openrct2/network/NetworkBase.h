@@ -5,13 +5,16 @@
 #include "../object/Object.h"
 #include "NetworkConnection.h"
 #include "NetworkGroup.h"
+#include "NetworkMapDelta.h"
 #include "NetworkPlayer.h"
 #include "NetworkServerAdvertiser.h"
 #include "NetworkTypes.h"
 #include "NetworkUser.h"
 
+#include <deque>
 #include <fstream>
 #include <memory>
+#include <vector>
 
 #ifndef DISABLE_NETWORK
 
@@ -36,6 +39,7 @@ public: // Common
     // FIXME: This is currently the wrong function to override in System, will be refactored later.
     void Update() override final;
     void Flush();
+    bool WaitForEvents(uint32_t timeoutMs);
     void ProcessPending();
     void ProcessPlayerList();
     auto GetPlayerIteratorByID(uint8_t id) const;
@@ -53,7 +57,7 @@ public: // Common
     void CloseChatLog();
     NetworkStats GetStats() const;
     json_t GetServerInfoAsJson() const;
-    bool ProcessConnection(NetworkConnection& connection);
+    bool ProcessConnection(NetworkConnection& connection, bool readable = true);
     void CloseConnection();
     NetworkPlayer* AddPlayer(const std::string& name, const std::string& keyhash);
     void ProcessPacket(NetworkConnection& connection, NetworkPacket& packet);
@@ -78,14 +82,13 @@ public: // Server
     void RemovePlayer(std::unique_ptr<NetworkConnection>& connection);
     void UpdateServer();
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
-    bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
-    std::vector<uint8_t> SaveForNetwork(const std::vector<const ObjectRepositoryItem*>& objects) const;
     std::string MakePlayerNameUnique(const std::string& name);
 
     // Packet dispatchers.
     void ServerSendAuth(NetworkConnection& connection);
     void ServerSendToken(NetworkConnection& connection);
     void ServerSendMap(NetworkConnection* connection = nullptr);
+    void ServerProcessPendingMaps();
     void ServerSendChat(const char* text, const std::vector<uint8_t>& playerIds = {});
     void ServerSendGameAction(const GameAction* action);
     void ServerSendTick();
@@ -131,6 +134,7 @@ public: // Client
     NetworkServerState GetServerState() const noexcept;
     void ServerClientDisconnected();
     bool LoadMap(OpenRCT2::IStream* stream);
+    void ReleaseMapDeltaBase();
     void UpdateClient();
 
     // Packet dispatchers.
@@ -197,8 +201,21 @@ private: // Common Data
 private: // Server Data
     std::unordered_map<NetworkCommand, CommandHandler> server_command_handlers;
     std::unique_ptr<ITcpSocket> _listenSocket;
+    // Only headless servers wait on their sockets, see WaitForEvents.
+    std::unique_ptr<ISocketPoller> _socketPoller;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
+    // Maps copied at a tick boundary that are still being written and encoded on a worker, in the order they were
+    // copied. The job shares its state with the server, so closing the server does not have to wait for it.
+    struct MapEncodeJob;
+    struct PendingMap
+    {
+        std::shared_ptr<MapEncodeJob> Job;
+        // Connections that close meanwhile are removed.
+        std::vector<NetworkConnection*> Connections;
+        bool Joining{};
+    };
+    std::deque<PendingMap> _pendingMaps;
     std::string _serverLogPath;
     std::string _serverLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
     std::ofstream _server_log_fs;
@@ -231,6 +248,10 @@ private: // Client Data
     std::multimap<uint32_t, NetworkPlayer> _pendingPlayerInfo;
     std::map<uint32_t, ServerTickData> _serverTickData;
     std::vector<ObjectEntryDescriptor> _missingObjects;
+    // The uncompressed park the client was in when it requested the map and the blocks whose hashes were sent with the
+    // request, map deltas refer to these blocks. Only kept until the map arrives.
+    std::vector<uint8_t> _lastMap;
+    std::vector<NetworkMapBlock> _lastMapBlocks;
     std::string _host;
     std::string _chatLogPath;
     std::string _chatLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
@@ -11,6 +11,7 @@
 
 #    include "NetworkConnection.h"
 
+#    include "../Diagnostic.h"
 #    include "../core/String.hpp"
 #    include "../localisation/Formatting.h"
 #    include "../localisation/Localisation.h"
@@ -18,8 +19,14 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <algorithm>
+#    include <iterator>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
 constexpr size_t NetworkBufferSize = 1024 * 64; // 64 KiB, maximum packet size.
+// Most a connection sends per update, so a client downloading the map does not hold up the others.
+constexpr size_t NetworkSendBudget = 1024 * 256;
+constexpr size_t NetworkMaxSendBuffers = 64;
 
 NetworkConnection::NetworkConnection() noexcept
 {
@@ -86,7 +93,7 @@ NetworkReadPacket NetworkConnection::ReadPacket()
             // Received complete packet.
             _lastPacketTime = Platform::GetTicks();
 
-            RecordPacketStats(InboundPacket, false);
+            RecordPacketStats(InboundPacket.GetCommand(), InboundPacket.BytesTransferred, false);
 
             return NetworkReadPacket::Success;
         }
@@ -95,61 +102,86 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
 {
-    auto header = packet.Header;
-
-    std::vector<uint8_t> buffer;
-    buffer.reserve(sizeof(header) + header.Size);
-
-    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
-    // Previously the Id field was not part of the header rather part of the body.
-    header.Size += sizeof(header.Id);
-    header.Size = Convert::HostToNetwork(header.Size);
-    header.Id = ByteSwapBE(header.Id);
-
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
-
-    size_t bufferSize = buffer.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer.data() + packet.BytesTransferred, bufferSize);
-    if (sent > 0)
-    {
-        packet.BytesTransferred += sent;
-    }
-
-    bool sendComplete = packet.BytesTransferred == buffer.size();
-    if (sendComplete)
+    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
     {
-        RecordPacketStats(packet, true);
+        QueuePacket(packet.Frame(), front);
     }
-    return sendComplete;
 }
 
-void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
+void NetworkConnection::QueuePacket(NetworkFramedPacketPtr packet, bool front)
 {
-    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    if (packet == nullptr)
+    {
+        DropOversizedPacket();
+        return;
+    }
+    if (AuthStatus == NetworkAuth::Ok || !packet->RequiresAuth)
     {
-        packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
-        if (front)
+        if (front && !_heldPackets.empty())
+        {
+            // Still has to arrive after the data the hold is waiting for, so it goes first among the held packets.
+            _heldPackets.back().push_front({ std::move(packet) });
+        }
+        else if (front)
         {
             // If the first packet was already partially sent add new packet to second position
             if (!_outboundPackets.empty() && _outboundPackets.front().BytesTransferred > 0)
             {
                 auto it = _outboundPackets.begin();
                 it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
+                _outboundPackets.insert(it, { std::move(packet) });
             }
             else
             {
-                _outboundPackets.push_front(std::move(packet));
+                _outboundPackets.push_front({ std::move(packet) });
             }
         }
+        else if (!_heldPackets.empty())
+        {
+            _heldPackets.back().push_back({ std::move(packet) });
+        }
         else
         {
-            _outboundPackets.push_back(std::move(packet));
+            _outboundPackets.push_back({ std::move(packet) });
+        }
+    }
+}
+
+void NetworkConnection::HoldPackets()
+{
+    _heldPackets.emplace_back();
+}
+
+void NetworkConnection::ReleasePackets(const std::vector<NetworkFramedPacketPtr>& packets)
+{
+    // Everything queued before the oldest hold is already in the outbound queue.
+    for (const auto& packet : packets)
+    {
+        if (packet == nullptr)
+        {
+            DropOversizedPacket();
+        }
+        else if (AuthStatus == NetworkAuth::Ok || !packet->RequiresAuth)
+        {
+            _outboundPackets.push_back({ packet });
         }
     }
+    if (!_heldPackets.empty())
+    {
+        auto& held = _heldPackets.front();
+        std::move(held.begin(), held.end(), std::back_inserter(_outboundPackets));
+        _heldPackets.pop_front();
+    }
+}
+
+void NetworkConnection::DropOversizedPacket()
+{
+    // The packets after it would be read as part of it, so the connection can not be used any more.
+    LOG_ERROR("Packet is too large to be sent, closing the connection");
+    SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+    Disconnect();
 }
 
 void NetworkConnection::Disconnect() noexcept
@@ -164,9 +196,51 @@ bool NetworkConnection::IsValid() const
 
 void NetworkConnection::SendQueuedPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
+    if (_outboundPackets.empty())
+    {
+        return;
+    }
+    Stats.sendFlushes++;
+
+    // Send as many queued packets per system call as possible, until the budget is spent or the socket is full.
+    size_t budget = NetworkSendBudget;
+    while (!_outboundPackets.empty() && budget > 0)
     {
-        _outboundPackets.pop_front();
+        SocketBuffer buffers[NetworkMaxSendBuffers];
+        size_t numBuffers = 0;
+        size_t batchSize = 0;
+        for (auto it = _outboundPackets.begin();
+             it != _outboundPackets.end() && numBuffers < NetworkMaxSendBuffers && batchSize < budget; it++)
+        {
+            const auto& data = it->Packet->Data;
+            const auto size = std::min(data.size() - it->BytesTransferred, budget - batchSize);
+            buffers[numBuffers++] = { data.data() + it->BytesTransferred, size };
+            batchSize += size;
+        }
+
+        const auto sent = Socket->SendData(buffers, numBuffers);
+        Stats.sendSyscalls++;
+        budget -= sent;
+
+        auto remaining = sent;
+        while (remaining > 0)
+        {
+            auto& packet = _outboundPackets.front();
+            const auto packetSize = packet.Packet->Data.size();
+            const auto transferred = std::min(packetSize - packet.BytesTransferred, remaining);
+            packet.BytesTransferred += transferred;
+            remaining -= transferred;
+            if (packet.BytesTransferred == packetSize)
+            {
+                RecordPacketStats(packet.Packet->Command, packetSize, true);
+                _outboundPackets.pop_front();
+            }
+        }
+
+        if (sent < batchSize)
+        {
+            break;
+        }
     }
 }
 
@@ -203,12 +277,12 @@ void NetworkConnection::SetLastDisconnectReason(const StringId string_id, void*
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+void NetworkConnection::RecordPacketStats(NetworkCommand command, size_t size, bool sending)
 {
-    uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
+    uint32_t packetSize = static_cast<uint32_t>(size);
     NetworkStatisticsGroup trafficGroup;
 
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NetworkCommand::GameAction:
             trafficGroup = NetworkStatisticsGroup::Commands;
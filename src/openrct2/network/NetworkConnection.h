@@ -12,6 +12,7 @@
 #ifndef DISABLE_NETWORK
 #    include "../common.h"
 #    include "NetworkKey.h"
+#    include "NetworkMapDelta.h"
 #    include "NetworkPacket.h"
 #    include "NetworkTypes.h"
 #    include "Socket.h"
@@ -36,17 +37,21 @@ public:
     NetworkKey Key;
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
+    // Hashes of the blocks of the last map the client loaded.
+    std::vector<NetworkMapBlockHash> MapBlockHashes;
     bool ShouldDisconnect = false;
 
     NetworkConnection() noexcept;
 
     NetworkReadPacket ReadPacket();
-    void QueuePacket(NetworkPacket&& packet, bool front = false);
-    void QueuePacket(const NetworkPacket& packet, bool front = false)
-    {
-        auto copy = packet;
-        return QueuePacket(std::move(copy), front);
-    }
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
+    void QueuePacket(NetworkFramedPacketPtr packet, bool front = false);
+
+    // Packets queued after a hold, including those queued at the front, are only sent after the packets passed to
+    // ReleasePackets, so they can follow data that is still being prepared. Holds are released in the order they were
+    // made.
+    void HoldPackets();
+    void ReleasePackets(const std::vector<NetworkFramedPacketPtr>& packets);
 
     // This will not immediately disconnect the client. The disconnect
     // will happen post-tick.
@@ -62,12 +67,20 @@ public:
     void SetLastDisconnectReason(const StringId string_id, void* args = nullptr);
 
 private:
-    std::deque<NetworkPacket> _outboundPackets;
+    struct OutboundPacket
+    {
+        NetworkFramedPacketPtr Packet;
+        size_t BytesTransferred = 0;
+    };
+
+    std::deque<OutboundPacket> _outboundPackets;
+    // The packets queued during each hold that has not been released yet.
+    std::deque<std::deque<OutboundPacket>> _heldPackets;
     uint32_t _lastPacketTime = 0;
     std::string _lastDisconnectReason;
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    void RecordPacketStats(NetworkCommand command, size_t size, bool sending);
+    void DropOversizedPacket();
 };
 
 #endif // DISABLE_NETWORK
@@ -0,0 +1,209 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkMapDelta.h"
+
+#    include "../core/MemoryStream.h"
+#    include "../util/Util.h"
+
+#    include <algorithm>
+#    include <array>
+#    include <map>
+#    include <stdexcept>
+
+using namespace OpenRCT2;
+
+// Blocks are 16 KiB on average, the hashes of a 30 MiB park add up to under 40 KiB.
+static constexpr size_t MapBlockMinSize = 4 * 1024;
+static constexpr size_t MapBlockMaxSize = 64 * 1024;
+static constexpr uint64_t MapBlockBoundaryMask = (1 << 14) - 1;
+
+// The size comes from the server, so it is capped well above the largest park rather than trusted. The delta itself is
+// at most the whole map as literal data plus a few bytes for every block.
+static constexpr uint64_t MapMaxSize = 512 * 1024 * 1024;
+static constexpr uint64_t MapDeltaMaxSize = MapMaxSize + MapMaxSize / 256;
+
+enum class MapDeltaOp : uint8_t
+{
+    Copy,
+    Literal,
+};
+
+#    pragma pack(push, 1)
+struct MapDeltaHeader
+{
+    uint64_t MapSize;
+    NetworkMapBlockHash MapHash;
+};
+#    pragma pack(pop)
+
+// Random values for every byte, both sides have to use the same ones to find the same boundaries.
+static constexpr std::array<uint64_t, 256> CreateGearTable()
+{
+    std::array<uint64_t, 256> table{};
+    uint64_t state = 0x4f70656e52435432;
+    for (auto& value : table)
+    {
+        // splitmix64
+        state += 0x9e3779b97f4a7c15;
+        auto z = state;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        value = z ^ (z >> 31);
+    }
+    return table;
+}
+
+static constexpr auto GearTable = CreateGearTable();
+
+static size_t FindBlockEnd(const uint8_t* data, size_t dataLen)
+{
+    if (dataLen <= MapBlockMinSize)
+    {
+        return dataLen;
+    }
+
+    const auto maxLen = std::min(dataLen, MapBlockMaxSize);
+    uint64_t hash = 0;
+    for (size_t i = MapBlockMinSize; i < maxLen; i++)
+    {
+        hash = (hash << 1) + GearTable[data[i]];
+        if ((hash & MapBlockBoundaryMask) == 0)
+        {
+            return i + 1;
+        }
+    }
+    return maxLen;
+}
+
+std::vector<NetworkMapBlock> NetworkMapSplitBlocks(const void* data, size_t dataLen)
+{
+    std::vector<NetworkMapBlock> blocks;
+    const auto* src = static_cast<const uint8_t*>(data);
+    size_t offset = 0;
+    while (offset < dataLen)
+    {
+        NetworkMapBlock block;
+        block.Offset = offset;
+        block.Length = FindBlockEnd(src + offset, dataLen - offset);
+        block.Hash = Crypt::SHA1(src + offset, block.Length);
+        blocks.push_back(block);
+        offset += block.Length;
+    }
+    return blocks;
+}
+
+std::vector<uint8_t> NetworkMapEncodeDelta(
+    const void* data, size_t dataLen, const std::vector<NetworkMapBlockHash>& baseHashes, int32_t level)
+{
+    std::map<NetworkMapBlockHash, uint32_t> baseBlockIndices;
+    for (size_t i = 0; i < baseHashes.size(); i++)
+    {
+        baseBlockIndices.emplace(baseHashes[i], static_cast<uint32_t>(i));
+    }
+
+    MemoryStream ms;
+    MapDeltaHeader header{};
+    header.MapSize = dataLen;
+    header.MapHash = Crypt::SHA1(data, dataLen);
+    ms.WriteValue(header);
+
+    // Blocks the client does not have are merged with the ones next to them.
+    const auto* src = static_cast<const uint8_t*>(data);
+    size_t literalStart = 0;
+    size_t literalLength = 0;
+    const auto flushLiteral = [&]() {
+        if (literalLength != 0)
+        {
+            ms.WriteValue(MapDeltaOp::Literal);
+            ms.WriteValue(static_cast<uint32_t>(literalLength));
+            ms.Write(src + literalStart, literalLength);
+            literalLength = 0;
+        }
+    };
+    for (const auto& block : NetworkMapSplitBlocks(data, dataLen))
+    {
+        auto it = baseBlockIndices.find(block.Hash);
+        if (it != baseBlockIndices.end())
+        {
+            flushLiteral();
+            ms.WriteValue(MapDeltaOp::Copy);
+            ms.WriteValue(it->second);
+        }
+        else
+        {
+            if (literalLength == 0)
+            {
+                literalStart = block.Offset;
+            }
+            literalLength += block.Length;
+        }
+    }
+    flushLiteral();
+
+    return ZstdChunked(ms.GetData(), static_cast<size_t>(ms.GetLength()), level);
+}
+
+std::vector<uint8_t> NetworkMapDecodeDelta(
+    const void* delta, size_t deltaLen, const std::vector<uint8_t>& base, const std::vector<NetworkMapBlock>& baseBlocks)
+{
+    const auto decompressed = UnzstdChunked(delta, deltaLen, MapDeltaMaxSize);
+    MemoryStream ms(decompressed.data(), decompressed.size());
+    const auto header = ms.ReadValue<MapDeltaHeader>();
+    const uint64_t mapSize = header.MapSize;
+    if (mapSize > MapMaxSize)
+    {
+        throw std::runtime_error("Map delta is too large");
+    }
+
+    std::vector<uint8_t> result;
+    while (ms.GetPosition() < ms.GetLength())
+    {
+        const auto op = ms.ReadValue<MapDeltaOp>();
+        if (op == MapDeltaOp::Copy)
+        {
+            const auto index = ms.ReadValue<uint32_t>();
+            if (index >= baseBlocks.size())
+            {
+                throw std::runtime_error("Map delta refers to a block that does not exist");
+            }
+            const auto& block = baseBlocks[index];
+            if (block.Offset + block.Length > base.size() || result.size() + block.Length > mapSize)
+            {
+                throw std::runtime_error("Map delta block is out of range");
+            }
+            result.insert(result.end(), base.begin() + block.Offset, base.begin() + block.Offset + block.Length);
+        }
+        else if (op == MapDeltaOp::Literal)
+        {
+            const auto length = ms.ReadValue<uint32_t>();
+            if (length > ms.GetLength() - ms.GetPosition() || result.size() + length > mapSize)
+            {
+                throw std::runtime_error("Map delta data is out of range");
+            }
+            const auto offset = result.size();
+            result.resize(offset + length);
+            ms.Read(result.data() + offset, length);
+        }
+        else
+        {
+            throw std::runtime_error("Unknown map delta operation");
+        }
+    }
+
+    if (result.size() != mapSize || Crypt::SHA1(result.data(), result.size()) != header.MapHash)
+    {
+        throw std::runtime_error("Map rebuilt from delta does not match the server's map");
+    }
+    return result;
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#    include "../core/Crypt.h"
+
+#    include <cstddef>
+#    include <cstdint>
+#    include <vector>
+
+using NetworkMapBlockHash = Crypt::Sha1Algorithm::Result;
+
+// How the data of the map packets is encoded.
+enum class NetworkMapEncoding : uint8_t
+{
+    // A compressed park file.
+    Park,
+    // An uncompressed park file encoded against the client's last map, see NetworkMapEncodeDelta.
+    Delta,
+};
+
+struct NetworkMapBlock
+{
+    size_t Offset{};
+    size_t Length{};
+    NetworkMapBlockHash Hash{};
+};
+
+/**
+ * Splits map data into blocks at boundaries picked by the content around them, so data inserted into or removed from
+ * the map only changes the blocks it touches rather than every block after it.
+ */
+std::vector<NetworkMapBlock> NetworkMapSplitBlocks(const void* data, size_t dataLen);
+
+/**
+ * Encodes the map as references to the blocks of the client's last map with the same hash and the data of the other
+ * blocks, then compresses it with ZstdChunked at the given level. Without any hashes the whole map is sent.
+ */
+std::vector<uint8_t> NetworkMapEncodeDelta(
+    const void* data, size_t dataLen, const std::vector<NetworkMapBlockHash>& baseHashes, int32_t level);
+
+/**
+ * Rebuilds the map from a delta and the map whose blocks were sent to the server. Throws when the delta is invalid or
+ * the rebuilt map is not the one the server encoded.
+ */
+std::vector<uint8_t> NetworkMapDecodeDelta(
+    const void* delta, size_t deltaLen, const std::vector<uint8_t>& base, const std::vector<NetworkMapBlock>& baseBlocks);
+
+#endif // DISABLE_NETWORK
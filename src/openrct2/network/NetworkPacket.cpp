@@ -12,6 +12,7 @@
 #    include "NetworkPacket.h"
 
 #    include "NetworkTypes.h"
+#    include "Socket.h"
 
 #    include <memory>
 
@@ -61,6 +62,29 @@ bool NetworkPacket::CommandRequiresAuth() const noexcept
     }
 }
 
+NetworkFramedPacketPtr NetworkPacket::Frame() const
+{
+    if (Data.size() > MaxDataSize)
+    {
+        return nullptr;
+    }
+
+    PacketHeader header;
+    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
+    // Previously the Id field was not part of the header rather part of the body.
+    header.Size = Convert::HostToNetwork(static_cast<uint16_t>(Data.size() + sizeof(header.Id)));
+    header.Id = ByteSwapBE(Header.Id);
+
+    auto framed = std::make_shared<NetworkFramedPacket>();
+    framed->Command = GetCommand();
+    framed->RequiresAuth = CommandRequiresAuth();
+    framed->Data.reserve(sizeof(header) + Data.size());
+    const auto* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+    framed->Data.insert(framed->Data.end(), headerBytes, headerBytes + sizeof(header));
+    framed->Data.insert(framed->Data.end(), Data.begin(), Data.end());
+    return framed;
+}
+
 void NetworkPacket::Write(const void* bytes, size_t size)
 {
     const uint8_t* src = reinterpret_cast<const uint8_t*>(bytes);
@@ -25,8 +25,23 @@ struct PacketHeader
 static_assert(sizeof(PacketHeader) == 6);
 #pragma pack(pop)
 
+/**
+ * A packet as it is sent, the header in network byte order followed by the body. It is not changed once it is built,
+ * so the same one can be queued on any number of connections.
+ */
+struct NetworkFramedPacket final
+{
+    NetworkCommand Command = NetworkCommand::Invalid;
+    bool RequiresAuth = true;
+    std::vector<uint8_t> Data;
+};
+using NetworkFramedPacketPtr = std::shared_ptr<const NetworkFramedPacket>;
+
 struct NetworkPacket final
 {
+    // The size in the header is 16 bits and counts the command as well as the body.
+    static constexpr size_t MaxDataSize = UINT16_MAX - sizeof(PacketHeader::Id);
+
     NetworkPacket() noexcept = default;
     NetworkPacket(NetworkCommand id) noexcept;
 
@@ -38,6 +53,9 @@ struct NetworkPacket final
     void Clear() noexcept;
     bool CommandRequiresAuth() const noexcept;
 
+    // Builds the header and body for sending, returns nullptr when the body is larger than MaxDataSize.
+    NetworkFramedPacketPtr Frame() const;
+
     const uint8_t* Read(size_t size);
     std::string_view ReadString();
 
@@ -145,4 +145,7 @@ struct NetworkStats
 {
     uint64_t bytesReceived[EnumValue(NetworkStatisticsGroup::Max)];
     uint64_t bytesSent[EnumValue(NetworkStatisticsGroup::Max)];
+    // Updates that had packets to send and the system calls it took to send them.
+    uint64_t sendFlushes;
+    uint64_t sendSyscalls;
 };
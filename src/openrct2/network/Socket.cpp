@@ -9,6 +9,7 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
 #    include <atomic>
 #    include <chrono>
 #    include <cmath>
@@ -16,6 +17,8 @@
 #    include <future>
 #    include <string>
 #    include <thread>
+#    include <unordered_set>
+#    include <vector>
 
 // clang-format off
 // MSVC: include <math.h> here otherwise PI gets defined twice
@@ -51,8 +54,13 @@
     #include <netinet/tcp.h>
     #include <unistd.h>
     #include <sys/ioctl.h>
+    #include <poll.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include <unistd.h>
+    #if defined(__linux__)
+        #include <sys/epoll.h>
+    #endif
     #include "../common.h"
     using SOCKET = int32_t;
     #define SOCKET_ERROR -1
@@ -70,7 +78,11 @@
 
 #    include "Socket.h"
 
+#    include "../platform/Platform.h"
+
 constexpr auto CONNECT_TIMEOUT = std::chrono::milliseconds(3000);
+// Well below IOV_MAX on every platform.
+constexpr size_t MAX_SEND_BUFFERS = 64;
 
 // RAII WSA initialisation needed for Windows
 #    ifdef _WIN32
@@ -281,6 +293,11 @@ public:
         return _status;
     }
 
+    SOCKET GetSocket() const noexcept
+    {
+        return _socket;
+    }
+
     const char* GetError() const override
     {
         return _error.empty() ? nullptr : _error.c_str();
@@ -571,6 +588,46 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketBuffer* buffers, size_t count) override
+    {
+        if (_status != SocketStatus::Connected)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        count = std::min(count, MAX_SEND_BUFFERS);
+#    ifdef _WIN32
+        WSABUF wsaBuffers[MAX_SEND_BUFFERS];
+        for (size_t i = 0; i < count; i++)
+        {
+            wsaBuffers[i].buf = static_cast<char*>(const_cast<void*>(buffers[i].Data));
+            wsaBuffers[i].len = static_cast<ULONG>(buffers[i].Size);
+        }
+        DWORD sentBytes = 0;
+        if (WSASend(_socket, wsaBuffers, static_cast<DWORD>(count), &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return sentBytes;
+#    else
+        iovec iov[MAX_SEND_BUFFERS];
+        for (size_t i = 0; i < count; i++)
+        {
+            iov[i].iov_base = const_cast<void*>(buffers[i].Data);
+            iov[i].iov_len = buffers[i].Size;
+        }
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        const auto sentBytes = sendmsg(_socket, &msg, FLAG_NO_PIPE);
+        if (sentBytes == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(sentBytes);
+#    endif
+    }
+
     NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SocketStatus::Connected)
@@ -861,6 +918,146 @@ private:
     }
 };
 
+#    ifdef __linux__
+class SocketPoller final : public ISocketPoller
+{
+private:
+    int _epoll = -1;
+    std::unordered_set<const ITcpSocket*> _ready;
+
+public:
+    SocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1)
+        {
+            throw SocketException("Unable to create epoll instance.");
+        }
+    }
+
+    ~SocketPoller() override
+    {
+        close(_epoll);
+    }
+
+    void Add(ITcpSocket& socket) override
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = &socket;
+        const auto fd = static_cast<TcpSocket&>(socket).GetSocket();
+        if (fd != INVALID_SOCKET && epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &ev) == -1)
+        {
+            LOG_WARNING("Unable to watch socket: %s", strerror(errno));
+        }
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        // Closed sockets have already left the set.
+        const auto fd = static_cast<TcpSocket&>(socket).GetSocket();
+        if (fd != INVALID_SOCKET)
+        {
+            epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, nullptr);
+        }
+        _ready.erase(&socket);
+    }
+
+    bool Wait(uint32_t timeoutMs) override
+    {
+        _ready.clear();
+        epoll_event events[64];
+        auto numEvents = epoll_wait(_epoll, events, static_cast<int>(std::size(events)), static_cast<int>(timeoutMs));
+        for (int i = 0; i < numEvents; i++)
+        {
+            _ready.insert(static_cast<const ITcpSocket*>(events[i].data.ptr));
+        }
+        return !_ready.empty();
+    }
+
+    bool IsReady(const ITcpSocket& socket) const override
+    {
+        return _ready.count(&socket) != 0;
+    }
+};
+#    else
+class SocketPoller final : public ISocketPoller
+{
+private:
+    std::vector<ITcpSocket*> _sockets;
+    std::vector<ITcpSocket*> _pollSockets;
+    std::vector<pollfd> _pollFds;
+    std::unordered_set<const ITcpSocket*> _ready;
+
+public:
+    void Add(ITcpSocket& socket) override
+    {
+        _sockets.push_back(&socket);
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        _sockets.erase(std::remove(_sockets.begin(), _sockets.end(), &socket), _sockets.end());
+        _ready.erase(&socket);
+    }
+
+    bool Wait(uint32_t timeoutMs) override
+    {
+        _ready.clear();
+
+        // Sockets may have been closed since they were added, so the handles are looked up on every wait.
+        _pollSockets.clear();
+        _pollFds.clear();
+        for (auto* socket : _sockets)
+        {
+            pollfd pfd{};
+            pfd.fd = static_cast<TcpSocket*>(socket)->GetSocket();
+            pfd.events = POLLIN;
+            if (pfd.fd != INVALID_SOCKET)
+            {
+                _pollSockets.push_back(socket);
+                _pollFds.push_back(pfd);
+            }
+        }
+        if (_pollFds.empty())
+        {
+            Platform::Sleep(timeoutMs);
+            return false;
+        }
+
+#        ifdef _WIN32
+        const auto numReady = WSAPoll(_pollFds.data(), static_cast<ULONG>(_pollFds.size()), static_cast<INT>(timeoutMs));
+#        else
+        const auto numReady = poll(_pollFds.data(), static_cast<nfds_t>(_pollFds.size()), static_cast<int>(timeoutMs));
+#        endif
+        if (numReady <= 0)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < _pollFds.size(); i++)
+        {
+            // Errors and hang ups are ready too, reading from the socket reports them.
+            if (_pollFds[i].revents != 0)
+            {
+                _ready.insert(_pollSockets[i]);
+            }
+        }
+        return !_ready.empty();
+    }
+
+    bool IsReady(const ITcpSocket& socket) const override
+    {
+        return _ready.count(&socket) != 0;
+    }
+};
+#    endif
+
+std::unique_ptr<ISocketPoller> CreateSocketPoller()
+{
+    InitialiseWSA();
+    return std::make_unique<SocketPoller>();
+}
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket()
 {
     InitialiseWSA();
@@ -45,6 +45,15 @@ struct INetworkEndpoint
     virtual std::string GetHostname() const abstract;
 };
 
+/**
+ * A piece of data for a vectored send.
+ */
+struct SocketBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
 /**
  * Represents a TCP socket / connection or listener.
  */
@@ -66,6 +75,8 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    // Sends the buffers one after the other in a single system call, returns how many bytes the socket accepted.
+    virtual size_t SendData(const SocketBuffer* buffers, size_t count) abstract;
     virtual NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void SetNoDelay(bool noDelay) abstract;
@@ -75,6 +86,24 @@ public:
     virtual void Close() abstract;
 };
 
+/**
+ * Waits for TCP sockets to have data to read, or for listening sockets to have connections to accept, so a server
+ * only has to look at the sockets that are ready. Uses epoll on Linux and poll everywhere else.
+ */
+struct ISocketPoller
+{
+public:
+    virtual ~ISocketPoller() = default;
+
+    virtual void Add(ITcpSocket& socket) abstract;
+    virtual void Remove(ITcpSocket& socket) abstract;
+
+    // Waits until a socket is ready or the timeout passes, returns whether any socket is ready.
+    virtual bool Wait(uint32_t timeoutMs) abstract;
+    // Whether the socket was ready after the last wait.
+    virtual bool IsReady(const ITcpSocket& socket) const abstract;
+};
+
 /**
  * Represents a UDP socket / listener.
  */
@@ -100,6 +129,7 @@ public:
 
 [[nodiscard]] std::unique_ptr<ITcpSocket> CreateTcpSocket();
 [[nodiscard]] std::unique_ptr<IUdpSocket> CreateUdpSocket();
+[[nodiscard]] std::unique_ptr<ISocketPoller> CreateSocketPoller();
 [[nodiscard]] std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
 namespace Convert
@@ -51,6 +51,9 @@ bool NetworkGamestateSnapshotsEnabled();
 void NetworkUpdate();
 void NetworkProcessPending();
 void NetworkFlush();
+// Sleeps until network traffic arrives or the timeout passes, handling the traffic. Returns false without sleeping when
+// the network can not be waited on.
+bool NetworkWaitForEvents(uint32_t timeoutMs);
 
 [[nodiscard]] NetworkAuth NetworkGetAuthstatus();
 [[nodiscard]] uint32_t NetworkGetServerTick();
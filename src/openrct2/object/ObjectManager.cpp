@@ -13,7 +13,9 @@
 #include "../ParkImporter.h"
 #include "../audio/audio.h"
 #include "../core/Console.hpp"
+#include "../core/JobPool.h"
 #include "../core/Memory.hpp"
+#include "../core/Timer.hpp"
 #include "../localisation/StringIds.h"
 #include "../ride/Ride.h"
 #include "../ride/RideAudio.h"
@@ -31,9 +33,9 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <memory>
 #include <mutex>
-#include <thread>
 #include <unordered_set>
 
 /**
@@ -47,6 +49,16 @@ struct ObjectToLoad
     ObjectEntryIndex Index{};
 };
 
+/**
+ * Time spent on a single object during LoadObjects, reading covers parsing the object file and decoding its
+ * images on a worker thread, loading covers registering the object and its images on the calling thread.
+ */
+struct ObjectLoadTime
+{
+    std::chrono::duration<float> ReadTime{};
+    std::chrono::duration<float> LoadTime{};
+};
+
 class ObjectManager final : public IObjectManager
 {
 private:
@@ -554,30 +566,6 @@ private:
         return requiredObjects;
     }
 
-    template<typename T, typename TFunc> static void ParallelFor(const std::vector<T>& items, TFunc func)
-    {
-        auto partitions = std::thread::hardware_concurrency();
-        auto partitionSize = (items.size() + (partitions - 1)) / partitions;
-        std::vector<std::thread> threads;
-        for (size_t n = 0; n < partitions; n++)
-        {
-            auto begin = n * partitionSize;
-            auto end = std::min(items.size(), begin + partitionSize);
-            threads.emplace_back(
-                [func](size_t pbegin, size_t pend) {
-                    for (size_t i = pbegin; i < pend; i++)
-                    {
-                        func(i);
-                    }
-                },
-                begin, end);
-        }
-        for (auto& t : threads)
-        {
-            t.join();
-        }
-    }
-
     void LoadObjects(std::vector<ObjectToLoad>& requiredObjects)
     {
         std::vector<Object*> objects;
@@ -605,14 +593,20 @@ private:
         std::sort(objectsToLoad.begin(), objectsToLoad.end());
         objectsToLoad.erase(std::unique(objectsToLoad.begin(), objectsToLoad.end()), objectsToLoad.end());
 
-        // Load the objects.
+        // Load the objects on the shared job pool, objects are handed out one at a time so a single slow
+        // object does not hold up a whole partition.
         std::mutex commonMutex;
-        ParallelFor(objectsToLoad, [&](size_t i) {
+        std::vector<size_t> newLoadedObjectIndices;
+        std::vector<ObjectLoadTime> loadTimes(objectsToLoad.size());
+        OpenRCT2::Timer totalTimer;
+        JobPool::GetShared().ParallelFor(objectsToLoad.size(), [&](size_t i) {
             const auto* requiredObject = objectsToLoad[i];
 
             // Object requires to be loaded, if the object successfully loads it will register it
             // as a loaded object otherwise placed into the badObjects list.
+            OpenRCT2::Timer readTimer;
             auto newObject = _objectRepository.LoadObject(requiredObject);
+            loadTimes[i].ReadTime = readTimer.GetElapsedTime();
 
             std::lock_guard<std::mutex> guard(commonMutex);
             if (newObject == nullptr)
@@ -623,6 +617,7 @@ private:
             else
             {
                 newLoadedObjects.push_back(newObject.get());
+                newLoadedObjectIndices.push_back(i);
                 // Connect the ori to the registered object
                 _objectRepository.RegisterLoadedObject(requiredObject, std::move(newObject));
             }
@@ -646,11 +641,15 @@ private:
         }
 
         // Load objects
-        for (auto* obj : newLoadedObjects)
+        for (size_t i = 0; i < newLoadedObjects.size(); i++)
         {
-            obj->Load();
+            OpenRCT2::Timer timer;
+            newLoadedObjects[i]->Load();
+            loadTimes[newLoadedObjectIndices[i]].LoadTime = timer.GetElapsedTime();
         }
 
+        LogObjectLoadTimes(objectsToLoad, loadTimes, totalTimer.GetElapsedTime());
+
         if (!badObjects.empty())
         {
             // Unload all the new objects we loaded
@@ -694,6 +693,46 @@ private:
         LOG_VERBOSE("%u / %u new objects loaded", newLoadedObjects.size(), requiredObjects.size());
     }
 
+    static void LogObjectLoadTimes(
+        const std::vector<const ObjectRepositoryItem*>& items, const std::vector<ObjectLoadTime>& loadTimes,
+        std::chrono::duration<float> totalTime)
+    {
+        static constexpr size_t MaxSlowestObjects = 10;
+
+        if (items.empty() || !_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
+            return;
+
+        std::chrono::duration<float> totalReadTime{};
+        std::chrono::duration<float> totalLoadTime{};
+        std::vector<size_t> order(items.size());
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            totalReadTime += loadTimes[i].ReadTime;
+            totalLoadTime += loadTimes[i].LoadTime;
+            order[i] = i;
+        }
+
+        const auto numSlowest = std::min(MaxSlowestObjects, order.size());
+        std::partial_sort(order.begin(), order.begin() + numSlowest, order.end(), [&loadTimes](size_t a, size_t b) {
+            return loadTimes[a].ReadTime + loadTimes[a].LoadTime > loadTimes[b].ReadTime + loadTimes[b].LoadTime;
+        });
+
+        using Milliseconds = std::chrono::duration<float, std::milli>;
+        LOG_VERBOSE(
+            "Loaded %zu objects in %.2f ms (read %.2f ms across %zu threads, load %.2f ms)", items.size(),
+            Milliseconds(totalTime).count(), Milliseconds(totalReadTime).count(), JobPool::GetShared().GetWorkerCount() + 1,
+            Milliseconds(totalLoadTime).count());
+        for (size_t n = 0; n < numSlowest; n++)
+        {
+            const auto& item = *items[order[n]];
+            const auto& loadTime = loadTimes[order[n]];
+            const auto name = item.Identifier.empty() ? std::string(item.ObjectEntry.GetName()) : item.Identifier;
+            LOG_VERBOSE(
+                "  %8.2f ms (read %.2f ms, load %.2f ms) %s", Milliseconds(loadTime.ReadTime + loadTime.LoadTime).count(),
+                Milliseconds(loadTime.ReadTime).count(), Milliseconds(loadTime.LoadTime).count(), name.c_str());
+        }
+    }
+
     Object* GetOrLoadObject(const ObjectRepositoryItem* ori)
     {
         auto* loadedObject = ori->LoadedObject.get();
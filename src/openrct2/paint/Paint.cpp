@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <array>
+#include <limits>
 
 using namespace OpenRCT2;
 
@@ -195,7 +196,7 @@ static PaintStruct* CreateNormalPaintStruct(
     return ps;
 }
 
-template<uint8_t direction> void PaintSessionGenerateRotate(PaintSession& session)
+template<uint8_t direction> void PaintSessionGenerateRotate(PaintSession& session, uint32_t firstRow, uint32_t numRows)
 {
     // Optimised modified version of ViewportPosToMapPos
     ScreenCoordsXY screenCoord = { Floor2(session.DPI.x, 32), Floor2((session.DPI.y - 16), 32) };
@@ -208,8 +209,6 @@ template<uint8_t direction> void PaintSessionGenerateRotate(PaintSession& sessio
     }
     mapTile = mapTile.ToTileStart();
 
-    uint16_t numVerticalTiles = (session.DPI.height + 2128) >> 5;
-
     // Adjacent tiles to also check due to overlapping of sprites
     constexpr CoordsXY adjacentTiles[] = {
         CoordsXY{ -32, 32 }.Rotate(direction),
@@ -217,8 +216,9 @@ template<uint8_t direction> void PaintSessionGenerateRotate(PaintSession& sessio
         CoordsXY{ 32, 0 }.Rotate(direction),
     };
     constexpr CoordsXY nextVerticalTile = CoordsXY{ 32, 32 }.Rotate(direction);
+    mapTile += nextVerticalTile * static_cast<int32_t>(firstRow);
 
-    for (; numVerticalTiles > 0; --numVerticalTiles)
+    for (; numRows > 0; --numRows)
     {
         TileElementPaintSetup(session, mapTile);
         EntityPaintSetup(session, mapTile);
@@ -243,24 +243,96 @@ template<uint8_t direction> void PaintSessionGenerateRotate(PaintSession& sessio
  */
 void PaintSessionGenerate(PaintSession& session)
 {
+    PaintSessionGenerate(session, 0, PaintSessionGetTileRowCount(session));
+}
+
+uint32_t PaintSessionGetTileRowCount(const PaintSession& session)
+{
+    return static_cast<uint16_t>((session.DPI.height + 2128) >> 5);
+}
+
+void PaintSessionGenerate(PaintSession& session, uint32_t firstRow, uint32_t numRows)
+{
+    const auto rowCount = PaintSessionGetTileRowCount(session);
+    if (firstRow >= rowCount)
+        return;
+    numRows = std::min(numRows, rowCount - firstRow);
+
     session.CurrentRotation = GetCurrentRotation();
     switch (DirectionFlipXAxis(session.CurrentRotation))
     {
         case 0:
-            PaintSessionGenerateRotate<0>(session);
+            PaintSessionGenerateRotate<0>(session, firstRow, numRows);
             break;
         case 1:
-            PaintSessionGenerateRotate<1>(session);
+            PaintSessionGenerateRotate<1>(session, firstRow, numRows);
             break;
         case 2:
-            PaintSessionGenerateRotate<2>(session);
+            PaintSessionGenerateRotate<2>(session, firstRow, numRows);
             break;
         case 3:
-            PaintSessionGenerateRotate<3>(session);
+            PaintSessionGenerateRotate<3>(session, firstRow, numRows);
             break;
     }
 }
 
+void PaintSessionMerge(PaintSession& session, PaintSession& part)
+{
+    PROFILED_FUNCTION();
+
+    // Structs are prepended to their quadrant, the structs of later rows go in front of the ones already there.
+    if (part.QuadrantBackIndex <= part.QuadrantFrontIndex)
+    {
+        for (auto i = part.QuadrantBackIndex; i <= part.QuadrantFrontIndex; i++)
+        {
+            auto* head = part.Quadrants[i];
+            if (head == nullptr)
+                continue;
+
+            auto* tail = head;
+            while (tail->NextQuadrantEntry != nullptr)
+            {
+                tail = tail->NextQuadrantEntry;
+            }
+            tail->NextQuadrantEntry = session.Quadrants[i];
+            session.Quadrants[i] = head;
+            part.Quadrants[i] = nullptr;
+        }
+        session.QuadrantBackIndex = std::min(session.QuadrantBackIndex, part.QuadrantBackIndex);
+        session.QuadrantFrontIndex = std::max(session.QuadrantFrontIndex, part.QuadrantFrontIndex);
+    }
+
+    if (part.PSStringHead != nullptr)
+    {
+        if (session.LastPSString == nullptr)
+        {
+            session.PSStringHead = part.PSStringHead;
+        }
+        else
+        {
+            session.LastPSString->NextEntry = part.PSStringHead;
+        }
+        session.LastPSString = part.LastPSString;
+    }
+    if (part.LastPS != nullptr)
+    {
+        session.LastPS = part.LastPS;
+    }
+    if (part.LastAttachedPS != nullptr)
+    {
+        session.LastAttachedPS = part.LastAttachedPS;
+    }
+
+    session.PaintEntryChain.Splice(part.PaintEntryChain);
+
+    part.QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
+    part.QuadrantFrontIndex = 0;
+    part.PSStringHead = nullptr;
+    part.LastPSString = nullptr;
+    part.LastPS = nullptr;
+    part.LastAttachedPS = nullptr;
+}
+
 template<uint8_t TRotation>
 static bool CheckBoundingBox(const PaintStructBoundBox& initialBBox, const PaintStructBoundBox& currentBBox)
 {
@@ -992,6 +1064,25 @@ void PaintEntryPool::Chain::Clear()
     assert(Current == nullptr);
 }
 
+void PaintEntryPool::Chain::Splice(Chain& chain)
+{
+    assert(Pool == chain.Pool);
+    if (chain.Head == nullptr)
+        return;
+
+    if (Current == nullptr)
+    {
+        Head = chain.Head;
+    }
+    else
+    {
+        Current->Next = chain.Head;
+    }
+    Current = chain.Current;
+    chain.Head = nullptr;
+    chain.Current = nullptr;
+}
+
 size_t PaintEntryPool::Chain::GetCount() const
 {
     size_t count = 0;
@@ -1026,7 +1117,12 @@ PaintEntryPool::Node* PaintEntryPool::AllocateNode()
     else
     {
         result = new (std::nothrow) PaintEntryPool::Node();
+        if (result == nullptr)
+            return nullptr;
+        _nodesAllocated++;
     }
+    _nodesInUse++;
+    _highWaterMark = std::max(_highWaterMark, _nodesInUse);
     return result;
 }
 
@@ -1046,6 +1142,51 @@ void PaintEntryPool::FreeNodes(PaintEntryPool::Node* head)
         node->Next = nullptr;
         node->Count = 0;
         _available.push_back(node);
+        _nodesInUse--;
         node = next;
     }
 }
+
+PaintEntryPool::Stats PaintEntryPool::GetStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Stats stats;
+    stats.NodesInUse = _nodesInUse;
+    stats.NodesTotal = _nodesInUse + _available.size();
+    stats.NodesAllocated = _nodesAllocated;
+    stats.HighWaterMark = _highWaterMark;
+    return stats;
+}
+
+void PaintEntryPool::ResetFrameStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _nodesAllocated = 0;
+    _highWaterMark = _nodesInUse;
+}
+
+void PaintEntryPool::Reserve(size_t numNodes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    while (_nodesInUse + _available.size() < numNodes)
+    {
+        auto* node = new (std::nothrow) PaintEntryPool::Node();
+        if (node == nullptr)
+            break;
+        _available.push_back(node);
+    }
+}
+
+void PaintEntryPool::Trim(size_t numNodes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    while (!_available.empty() && _nodesInUse + _available.size() > numNodes)
+    {
+        delete _available.back();
+        _available.pop_back();
+    }
+}
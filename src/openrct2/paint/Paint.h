@@ -136,9 +136,21 @@ static constexpr int32_t MaxPaintQuadrants = MAXIMUM_MAP_SIZE_TECHNICAL * 2;
  */
 class PaintEntryPool
 {
+public:
     static constexpr size_t NodeSize = 512;
 
-public:
+    struct Stats
+    {
+        // Nodes currently rented out to paint sessions.
+        size_t NodesInUse{};
+        // Nodes owned by the pool, rented out or not.
+        size_t NodesTotal{};
+        // Nodes that had to be allocated since the frame stats were last reset.
+        size_t NodesAllocated{};
+        // Most nodes in use at once since the frame stats were last reset.
+        size_t HighWaterMark{};
+    };
+
     struct Node
     {
         Node* Next{};
@@ -162,11 +174,17 @@ public:
         PaintEntry* Allocate();
         void Clear();
         size_t GetCount() const;
+
+        // Moves the nodes of another chain of the same pool to the end of this one.
+        void Splice(Chain& chain);
     };
 
 private:
     std::vector<Node*> _available;
     std::mutex _mutex;
+    size_t _nodesInUse{};
+    size_t _nodesAllocated{};
+    size_t _highWaterMark{};
 
     Node* AllocateNode();
 
@@ -175,6 +193,15 @@ public:
 
     Chain Create();
     void FreeNodes(Node* head);
+
+    Stats GetStats();
+    void ResetFrameStats();
+
+    // Allocates nodes up front until the pool owns at least the given number of nodes.
+    void Reserve(size_t numNodes);
+
+    // Releases available nodes until the pool owns no more than the given number of nodes.
+    void Trim(size_t numNodes);
 };
 
 struct PaintSessionCore
@@ -339,6 +366,23 @@ void PaintFloatingMoneyEffect(
 PaintSession* PaintSessionAlloc(DrawPixelInfo& dpi, uint32_t viewFlags);
 void PaintSessionFree(PaintSession* session);
 void PaintSessionGenerate(PaintSession& session);
+
+/**
+ * Returns the number of tile rows PaintSessionGenerate walks for the session, from the back of the view to the front.
+ */
+uint32_t PaintSessionGetTileRowCount(const PaintSession& session);
+
+/**
+ * Generates the paint structs of a range of the tile rows of the session. Ranges of the same view can be generated
+ * in separate sessions at the same time and merged afterwards.
+ */
+void PaintSessionGenerate(PaintSession& session, uint32_t firstRow, uint32_t numRows);
+
+/**
+ * Moves the paint structs of a session generated for the tile rows following the ones of the target session into
+ * it. Merging the parts of a view in row order gives the same quadrant lists as generating the view at once.
+ */
+void PaintSessionMerge(PaintSession& session, PaintSession& part);
 void PaintSessionArrange(PaintSessionCore& session);
 void PaintDrawStructs(PaintSession& session);
 void PaintDrawMoneyStructs(DrawPixelInfo& dpi, PaintStringStruct* ps);
@@ -0,0 +1,95 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PaintCapture.h"
+
+#include "../config/Config.h"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../interface/Window.h"
+#include "../scenario/Scenario.h"
+
+#include <stdexcept>
+
+static constexpr int32_t PaintCaptureVersion = 1;
+
+PaintCapture PaintCaptureCreate(const Viewport& viewport, uint8_t rotation)
+{
+    PaintCapture capture;
+    capture.ViewPos = viewport.viewPos;
+    capture.Width = viewport.width;
+    capture.Height = viewport.height;
+    capture.Zoom = viewport.zoom;
+    capture.Rotation = rotation;
+    capture.ViewFlags = viewport.flags;
+    return capture;
+}
+
+Viewport PaintCaptureGetViewport(const PaintCapture& capture)
+{
+    Viewport viewport{};
+    viewport.viewPos = capture.ViewPos;
+    viewport.width = capture.Width;
+    viewport.height = capture.Height;
+    viewport.view_width = capture.Zoom.ApplyTo(capture.Width);
+    viewport.view_height = capture.Zoom.ApplyTo(capture.Height);
+    viewport.zoom = capture.Zoom;
+    viewport.flags = capture.ViewFlags;
+    return viewport;
+}
+
+bool PaintCaptureSave(PaintCapture& capture, u8string_view path)
+{
+    const auto parkPath = Path::WithExtension(path, ".park");
+    if (!ScenarioSave(parkPath, gConfigGeneral.SavePluginData ? 1 : 0))
+        return false;
+    capture.ParkPath = Path::GetFileName(parkPath);
+
+    json_t jsonCapture = {
+        { "version", PaintCaptureVersion },
+        { "park", capture.ParkPath },
+        { "x", capture.ViewPos.x },
+        { "y", capture.ViewPos.y },
+        { "width", capture.Width },
+        { "height", capture.Height },
+        { "zoom", static_cast<int8_t>(capture.Zoom) },
+        { "rotation", capture.Rotation },
+        { "viewFlags", capture.ViewFlags },
+    };
+    Json::WriteToFile(path, jsonCapture);
+    return true;
+}
+
+PaintCapture PaintCaptureLoad(u8string_view path)
+{
+    auto jsonCapture = Json::AsObject(Json::ReadFromFile(path));
+    if (Json::GetNumber<int32_t>(jsonCapture["version"]) != PaintCaptureVersion)
+    {
+        throw std::runtime_error("Unsupported paint capture version.");
+    }
+
+    PaintCapture capture;
+    capture.ParkPath = Json::GetString(jsonCapture["park"]);
+    if (capture.ParkPath.empty())
+    {
+        throw std::runtime_error("Paint capture has no park.");
+    }
+    capture.ParkPath = Path::GetAbsolute(Path::Combine(Path::GetDirectory(path), capture.ParkPath));
+    capture.ViewPos = { Json::GetNumber<int32_t>(jsonCapture["x"]), Json::GetNumber<int32_t>(jsonCapture["y"]) };
+    capture.Width = Json::GetNumber<int32_t>(jsonCapture["width"]);
+    capture.Height = Json::GetNumber<int32_t>(jsonCapture["height"]);
+    capture.Zoom = ZoomLevel{ Json::GetNumber<int8_t>(jsonCapture["zoom"]) };
+    capture.Rotation = Json::GetNumber<uint8_t>(jsonCapture["rotation"]) & 3;
+    capture.ViewFlags = Json::GetNumber<uint32_t>(jsonCapture["viewFlags"]);
+    if (capture.Width <= 0 || capture.Height <= 0)
+    {
+        throw std::runtime_error("Paint capture has an invalid size.");
+    }
+    return capture;
+}
@@ -0,0 +1,52 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../core/String.hpp"
+#include "../interface/ZoomLevel.h"
+#include "../world/Location.hpp"
+
+#include <cstdint>
+
+struct Viewport;
+
+/**
+ * Everything needed to paint a view again outside of the game: the park it shows and the viewport it was painted
+ * through. Captures are stored as a json file next to a copy of the park.
+ */
+struct PaintCapture
+{
+    // Park file, relative to the capture file when it is stored next to it.
+    u8string ParkPath;
+    ScreenCoordsXY ViewPos;
+    int32_t Width{};
+    int32_t Height{};
+    ZoomLevel Zoom{};
+    uint8_t Rotation{};
+    uint32_t ViewFlags{};
+};
+
+PaintCapture PaintCaptureCreate(const Viewport& viewport, uint8_t rotation);
+
+/**
+ * Returns a viewport with the size, position and flags of the capture, positioned at the top left of the screen.
+ */
+Viewport PaintCaptureGetViewport(const PaintCapture& capture);
+
+/**
+ * Saves the current park next to the capture file and writes the capture, returns false if the park could not be
+ * saved. Throws if the capture file cannot be written.
+ */
+bool PaintCaptureSave(PaintCapture& capture, u8string_view path);
+
+/**
+ * Reads a capture file, the park path is made absolute. Throws if the file cannot be read or is not a capture.
+ */
+PaintCapture PaintCaptureLoad(u8string_view path);
@@ -16,6 +16,7 @@
 #include "../config/Config.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/IDrawingEngine.h"
+#include "../drawing/SpriteCache.h"
 #include "../interface/Chat.h"
 #include "../interface/InteractiveConsole.h"
 #include "../localisation/FormatCodes.h"
@@ -27,6 +28,8 @@
 #include "../ui/UiContext.h"
 #include "../world/TileInspector.h"
 
+#include <algorithm>
+
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 using namespace OpenRCT2::Paint;
@@ -41,6 +44,8 @@ void Painter::Paint(IDrawingEngine& de)
 {
     PROFILED_FUNCTION();
 
+    BeginFrame();
+
     auto dpi = de.GetDrawingPixelInfo();
     if (gIntroState != IntroState::None)
     {
@@ -82,6 +87,8 @@ void Painter::Paint(IDrawingEngine& de)
         PaintFPS(*dpi);
     }
     gCurrentDrawCount++;
+
+    EndFrame();
 }
 
 void Painter::PaintReplayNotice(DrawPixelInfo& dpi, const char* text)
@@ -151,8 +158,13 @@ PaintSession* Painter::CreateSession(DrawPixelInfo& dpi, uint32_t viewFlags)
         // Create new one in pool.
         _paintSessionPool.emplace_back(std::make_unique<PaintSession>());
         session = _paintSessionPool.back().get();
+        _frameStats.SessionsCreated++;
     }
 
+    _frameStats.Sessions++;
+    _sessionsInUse++;
+    _sessionsHighWaterMark = std::max(_sessionsHighWaterMark, _sessionsInUse);
+
     session->DPI = dpi;
     session->ViewFlags = viewFlags;
     session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
@@ -179,15 +191,90 @@ void Painter::ReleaseSession(PaintSession* session)
 {
     PROFILED_FUNCTION();
 
+    const auto numEntries = session->PaintEntryChain.GetCount();
+    _frameStats.Entries += numEntries;
+    _frameStats.MaxSessionEntries = std::max(_frameStats.MaxSessionEntries, numEntries);
+    _sessionsInUse--;
+
     session->PaintEntryChain.Clear();
     _freePaintSessions.push_back(session);
 }
 
 Painter::~Painter()
 {
-    for (auto&& session : _paintSessionPool)
+    // Destroying the sessions returns their paint entries to the pool, which must still exist.
+    _freePaintSessions.clear();
+    _paintSessionPool.clear();
+}
+
+const PaintFrameStats& Painter::GetLastFrameStats() const
+{
+    return _lastFrameStats;
+}
+
+void Painter::BeginFrame()
+{
+    PROFILED_FUNCTION();
+
+    const auto maxNodes = *std::max_element(_nodeHistory.begin(), _nodeHistory.end());
+    const auto maxSessions = *std::max_element(_sessionHistory.begin(), _sessionHistory.end());
+
+    // Leave some headroom so panning to a slightly busier view does not allocate while painting, the columns
+    // are generated in parallel and would all wait on the pool lock.
+    const auto targetNodes = maxNodes + maxNodes / 4;
+    _paintStructPool.Reserve(targetNodes);
+
+    // Give memory back once the busy frames that needed it have left the history.
+    if (_numFramesRecorded >= PoolHistorySize)
+    {
+        _paintStructPool.Trim(std::max<size_t>(targetNodes * 2, 1));
+    }
+
+    while (_paintSessionPool.size() < maxSessions)
+    {
+        _paintSessionPool.emplace_back(std::make_unique<PaintSession>());
+        _freePaintSessions.push_back(_paintSessionPool.back().get());
+    }
+}
+
+void Painter::EndFrame()
+{
+    PROFILED_FUNCTION();
+
+    const auto poolStats = _paintStructPool.GetStats();
+    _frameStats.NodesAllocated = poolStats.NodesAllocated;
+    _frameStats.NodesHighWaterMark = poolStats.HighWaterMark;
+    _frameStats.NodesTotal = poolStats.NodesTotal;
+
+    const auto historyIndex = _numFramesRecorded % PoolHistorySize;
+    _nodeHistory[historyIndex] = poolStats.HighWaterMark;
+    _sessionHistory[historyIndex] = _sessionsHighWaterMark;
+    _numFramesRecorded++;
+
+    SpriteCacheApplyConfig();
+
+    if (Profiling::IsEnabled())
     {
-        ReleaseSession(session.get());
+        Profiling::SetCounter("paint_sessions", _frameStats.Sessions);
+        Profiling::SetCounter("paint_sessions_created", _frameStats.SessionsCreated);
+        Profiling::SetCounter("paint_entries", _frameStats.Entries);
+        Profiling::SetCounter("paint_entries_max_session", _frameStats.MaxSessionEntries);
+        Profiling::SetCounter("paint_nodes_allocated", _frameStats.NodesAllocated);
+        Profiling::SetCounter("paint_nodes_high_water_mark", _frameStats.NodesHighWaterMark);
+        Profiling::SetCounter("paint_nodes_total", _frameStats.NodesTotal);
+
+        auto& spriteCache = GetSpriteCache();
+        const auto spriteCacheStats = spriteCache.GetStats();
+        Profiling::SetCounter("sprite_cache_hits", spriteCacheStats.Hits);
+        Profiling::SetCounter("sprite_cache_misses", spriteCacheStats.Misses);
+        Profiling::SetCounter("sprite_cache_evictions", spriteCacheStats.Evictions);
+        Profiling::SetCounter("sprite_cache_entries", spriteCacheStats.NumEntries);
+        Profiling::SetCounter("sprite_cache_memory", spriteCacheStats.MemoryUsage);
+        spriteCache.ResetStats();
     }
-    _paintSessionPool.clear();
+
+    _lastFrameStats = _frameStats;
+    _frameStats = {};
+    _sessionsHighWaterMark = _sessionsInUse;
+    _paintStructPool.ResetFrameStats();
 }
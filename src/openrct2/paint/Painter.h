@@ -12,6 +12,7 @@
 #include "../common.h"
 #include "Paint.h"
 
+#include <array>
 #include <ctime>
 #include <memory>
 #include <vector>
@@ -32,13 +33,41 @@ namespace OpenRCT2
 
     namespace Paint
     {
+        struct PaintFrameStats
+        {
+            // Paint sessions used, one per viewport column.
+            size_t Sessions{};
+            // Paint sessions that had to be created.
+            size_t SessionsCreated{};
+            // Paint entries used by all sessions.
+            size_t Entries{};
+            // Most paint entries used by a single session.
+            size_t MaxSessionEntries{};
+            // Paint entry nodes that had to be allocated.
+            size_t NodesAllocated{};
+            // Most paint entry nodes in use at once.
+            size_t NodesHighWaterMark{};
+            // Paint entry nodes owned by the pool.
+            size_t NodesTotal{};
+        };
+
         struct Painter final
         {
         private:
+            // Number of frames the pools are sized for, roughly a few seconds.
+            static constexpr size_t PoolHistorySize = 128;
+
             std::shared_ptr<Ui::IUiContext> const _uiContext;
             std::vector<std::unique_ptr<PaintSession>> _paintSessionPool;
             std::vector<PaintSession*> _freePaintSessions;
             PaintEntryPool _paintStructPool;
+            PaintFrameStats _frameStats;
+            PaintFrameStats _lastFrameStats;
+            size_t _sessionsInUse = 0;
+            size_t _sessionsHighWaterMark = 0;
+            std::array<size_t, PoolHistorySize> _nodeHistory{};
+            std::array<size_t, PoolHistorySize> _sessionHistory{};
+            size_t _numFramesRecorded = 0;
             time_t _lastSecond = 0;
             int32_t _currentFPS = 0;
             int32_t _frames = 0;
@@ -51,6 +80,15 @@ namespace OpenRCT2
             void ReleaseSession(PaintSession* session);
             ~Painter();
 
+            // Pool usage of the last completed frame.
+            const PaintFrameStats& GetLastFrameStats() const;
+
+            // Sizes the pools for the busiest recent frame so painting does not have to allocate.
+            void BeginFrame();
+
+            // Records the pool usage of the frame and publishes it to the profiler.
+            void EndFrame();
+
         private:
             void PaintReplayNotice(DrawPixelInfo& dpi, const char* text);
             void PaintFPS(DrawPixelInfo& dpi);
@@ -57,11 +57,14 @@
 #include "../world/Scenery.h"
 #include "Legacy.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <ctime>
+#include <deque>
 #include <numeric>
 #include <optional>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 constexpr uint32_t BlockBrakeImprovementsVersion = 27;
@@ -102,13 +105,36 @@ namespace OpenRCT2
         ObjectList RequiredObjects;
         std::vector<const ObjectRepositoryItem*> ExportObjectsList;
         bool OmitTracklessRides{};
+        uint32_t Compression = OrcaStream::COMPRESSION_GZIP;
+        int32_t CompressionLevel = GzipLevelDefault;
 
     private:
+        // Chunks are read from the file as they are needed, so it is kept open along with the stream reading it.
+        std::unique_ptr<FileStream> _fileStream;
         std::unique_ptr<OrcaStream> _os;
         ObjectEntryIndex _pathToSurfaceMap[MAX_PATH_OBJECTS];
         ObjectEntryIndex _pathToQueueSurfaceMap[MAX_PATH_OBJECTS];
         ObjectEntryIndex _pathToRailingsMap[MAX_PATH_OBJECTS];
 
+        template<typename... T> using EntityVectors = std::tuple<std::vector<T>...>;
+
+        // Copies of the map and entities taken by BeginSave, which FinishSave writes in place of the game state.
+        struct SaveSnapshot
+        {
+            TileCoordsXY MapSize;
+            std::vector<TileElement> TileElements;
+            EntityVectors<
+                Vehicle, Guest, Staff, Litter, SteamParticle, MoneyEffect, VehicleCrashParticle, ExplosionCloud,
+                CrashSplashParticle, ExplosionFlare, JumpingFountain, Balloon, Duck>
+                Entities;
+            // The copied peeps point at these, not at the names and patrol areas of the entities they were copied from.
+            std::deque<std::string> PeepNames;
+            std::vector<std::unique_ptr<PatrolArea>> PatrolAreas;
+            RideUse::RideHistory RideHistory;
+            RideUse::RideTypeHistory RideTypeHistory;
+        };
+        std::unique_ptr<SaveSnapshot> _snapshot;
+
         void ThrowIfIncompatibleVersion()
         {
             const auto& header = _os->GetHeader();
@@ -118,6 +144,19 @@ namespace OpenRCT2
             }
         }
 
+        // Only parks that use a compression mode older versions can not decode are marked as incompatible with them.
+        static uint32_t GetMinVersion(uint32_t compression)
+        {
+            switch (compression)
+            {
+                case OrcaStream::COMPRESSION_GZIP_CHUNKED:
+                case OrcaStream::COMPRESSION_ZSTD_CHUNKED:
+                    return std::max(PARK_FILE_MIN_VERSION, PARK_FILE_CHUNKED_MIN_VERSION);
+                default:
+                    return PARK_FILE_MIN_VERSION;
+            }
+        }
+
     public:
         bool IsSemiCompatibleVersion(uint32_t& minVersion, uint32_t& targetVersion)
         {
@@ -129,8 +168,8 @@ namespace OpenRCT2
 
         void Load(const std::string_view path)
         {
-            FileStream fs(path, FILE_MODE_OPEN);
-            Load(fs);
+            _fileStream = std::make_unique<FileStream>(path, FILE_MODE_OPEN);
+            Load(*_fileStream);
         }
 
         void Load(IStream& stream)
@@ -171,20 +210,34 @@ namespace OpenRCT2
 
         void Save(IStream& stream)
         {
-            OrcaStream os(stream, OrcaStream::Mode::WRITING);
+            BeginSave(stream, false);
+            FinishSave();
+        }
+
+        /**
+         * Writes every chunk but the tiles and entities. With takeSnapshot set those are copied, so FinishSave no
+         * longer reads the game state and can run on another thread while the game goes on.
+         */
+        void BeginSave(IStream& stream, bool takeSnapshot)
+        {
+            _os = std::make_unique<OrcaStream>(stream, OrcaStream::Mode::WRITING);
+            auto& os = *_os;
 
             auto& header = os.GetHeader();
             header.Magic = PARK_FILE_MAGIC;
             header.TargetVersion = PARK_FILE_CURRENT_VERSION;
-            header.MinVersion = PARK_FILE_MIN_VERSION;
+            header.MinVersion = GetMinVersion(Compression);
+            header.Compression = Compression;
+            os.SetCompressionLevel(CompressionLevel);
 
+            // What loading the objects and reading the scenario details need comes first, so they can be read
+            // without decompressing the map of a gzip compressed park. The tiles and entities come last, in FinishSave.
             ReadWriteAuthoringChunk(os);
             ReadWriteObjectsChunk(os);
-            ReadWriteTilesChunk(os);
+            ReadWritePackedObjectsChunk(os);
+            ReadWriteScenarioChunk(os);
             ReadWriteBannersChunk(os);
             ReadWriteRidesChunk(os);
-            ReadWriteEntitiesChunk(os);
-            ReadWriteScenarioChunk(os);
             ReadWriteGeneralChunk(os);
             ReadWriteParkChunk(os);
             ReadWriteClimateChunk(os);
@@ -194,7 +247,21 @@ namespace OpenRCT2
             ReadWriteCheatsChunk(os);
             ReadWriteRestrictedObjectsChunk(os);
             ReadWritePluginStorageChunk(os);
-            ReadWritePackedObjectsChunk(os);
+
+            if (takeSnapshot)
+            {
+                TakeSaveSnapshot();
+            }
+        }
+
+        void FinishSave()
+        {
+            ReadWriteTilesChunk(*_os);
+            ReadWriteEntitiesChunk(*_os);
+
+            // The park is written to the stream once the last chunk is in.
+            _os = nullptr;
+            _snapshot = nullptr;
         }
 
         void Save(const std::string_view path)
@@ -1052,12 +1119,15 @@ namespace OpenRCT2
             auto* pathToSurfaceMap = _pathToSurfaceMap;
             auto* pathToQueueSurfaceMap = _pathToQueueSurfaceMap;
             auto* pathToRailingsMap = _pathToRailingsMap;
+            auto* snapshot = _snapshot.get();
 
             auto found = os.ReadWriteChunk(
                 ParkFileChunkType::TILES,
-                [pathToSurfaceMap, pathToQueueSurfaceMap, pathToRailingsMap, &os](OrcaStream::ChunkStream& cs) {
-                    cs.ReadWrite(gMapSize.x);
-                    cs.ReadWrite(gMapSize.y);
+                [pathToSurfaceMap, pathToQueueSurfaceMap, pathToRailingsMap, snapshot,
+                 &os](OrcaStream::ChunkStream& cs) {
+                    auto& mapSize = snapshot != nullptr ? snapshot->MapSize : gMapSize;
+                    cs.ReadWrite(mapSize.x);
+                    cs.ReadWrite(mapSize.y);
 
                     if (cs.GetMode() == OrcaStream::Mode::READING)
                     {
@@ -1130,7 +1200,8 @@ namespace OpenRCT2
                     }
                     else
                     {
-                        auto tileElements = GetReorganisedTileElementsWithoutGhosts();
+                        auto tileElements = snapshot != nullptr ? std::move(snapshot->TileElements)
+                                                                : GetReorganisedTileElementsWithoutGhosts();
                         cs.Write(static_cast<uint32_t>(tileElements.size()));
                         cs.Write(tileElements.data(), tileElements.size() * sizeof(TileElement));
                     }
@@ -1585,7 +1656,7 @@ namespace OpenRCT2
             }
         }
 
-        template<typename T> static void ReadWriteEntity(OrcaStream& os, OrcaStream::ChunkStream& cs, T& entity);
+        template<typename T> void ReadWriteEntity(OrcaStream& os, OrcaStream::ChunkStream& cs, T& entity);
 
         static void ReadWriteEntityCommon(OrcaStream::ChunkStream& cs, EntityBase& entity)
         {
@@ -1983,6 +2054,9 @@ namespace OpenRCT2
         template<typename T> void WriteEntitiesOfType(OrcaStream& os, OrcaStream::ChunkStream& cs);
         template<typename... T> void WriteEntitiesOfTypes(OrcaStream& os, OrcaStream::ChunkStream& cs);
 
+        template<typename T> void CopyEntitiesOfType(std::vector<T>& entities);
+        void TakeSaveSnapshot();
+
         template<typename T> void ReadEntitiesOfType(OrcaStream& os, OrcaStream::ChunkStream& cs);
 
         template<typename... T> void ReadEntitiesOfTypes(OrcaStream& os, OrcaStream::ChunkStream& cs);
@@ -2229,7 +2303,10 @@ namespace OpenRCT2
             }
             else
             {
-                auto* rideUse = OpenRCT2::RideUse::GetHistory().GetAll(guest.Id);
+                auto& rideHistory = _snapshot != nullptr ? _snapshot->RideHistory : OpenRCT2::RideUse::GetHistory();
+                auto& rideTypeHistory = _snapshot != nullptr ? _snapshot->RideTypeHistory
+                                                             : OpenRCT2::RideUse::GetTypeHistory();
+                auto* rideUse = rideHistory.GetAll(guest.Id);
                 if (rideUse == nullptr)
                 {
                     std::vector<RideId> empty;
@@ -2239,7 +2316,7 @@ namespace OpenRCT2
                 {
                     cs.ReadWriteVector(*rideUse, [&cs](RideId& rideId) { cs.ReadWrite(rideId); });
                 }
-                auto* rideTypeUse = OpenRCT2::RideUse::GetTypeHistory().GetAll(guest.Id);
+                auto* rideTypeUse = rideTypeHistory.GetAll(guest.Id);
                 if (rideTypeUse == nullptr)
                 {
                     std::vector<ObjectEntryIndex> empty;
@@ -2448,6 +2525,19 @@ namespace OpenRCT2
 
     template<typename T> void ParkFile::WriteEntitiesOfType(OrcaStream& os, OrcaStream::ChunkStream& cs)
     {
+        if (_snapshot != nullptr)
+        {
+            auto& entities = std::get<std::vector<T>>(_snapshot->Entities);
+            cs.Write(T::cEntityType);
+            cs.Write(static_cast<uint16_t>(entities.size()));
+            for (auto& ent : entities)
+            {
+                cs.Write(ent.Id);
+                ReadWriteEntity(os, cs, ent);
+            }
+            return;
+        }
+
         uint16_t count = GetEntityListCount(T::cEntityType);
         cs.Write(T::cEntityType);
         cs.Write(count);
@@ -2463,6 +2553,41 @@ namespace OpenRCT2
         (WriteEntitiesOfType<T>(os, cs), ...);
     }
 
+    template<typename T> void ParkFile::CopyEntitiesOfType(std::vector<T>& entities)
+    {
+        entities.reserve(GetEntityListCount(T::cEntityType));
+        for (auto* ent : EntityList<T>())
+        {
+            auto& copy = entities.emplace_back(*ent);
+            if constexpr (std::is_base_of_v<Peep, T>)
+            {
+                if (copy.Name != nullptr)
+                {
+                    copy.Name = _snapshot->PeepNames.emplace_back(copy.Name).data();
+                }
+            }
+            if constexpr (std::is_same_v<T, Staff>)
+            {
+                if (copy.PatrolInfo != nullptr)
+                {
+                    auto patrolArea = std::make_unique<PatrolArea>(*copy.PatrolInfo);
+                    copy.PatrolInfo = patrolArea.get();
+                    _snapshot->PatrolAreas.push_back(std::move(patrolArea));
+                }
+            }
+        }
+    }
+
+    void ParkFile::TakeSaveSnapshot()
+    {
+        _snapshot = std::make_unique<SaveSnapshot>();
+        _snapshot->MapSize = gMapSize;
+        _snapshot->TileElements = GetReorganisedTileElementsWithoutGhosts();
+        std::apply([this](auto&... entities) { (CopyEntitiesOfType(entities), ...); }, _snapshot->Entities);
+        _snapshot->RideHistory = RideUse::GetHistory();
+        _snapshot->RideTypeHistory = RideUse::GetTypeHistory();
+    }
+
     template<typename T> void ParkFile::ReadEntitiesOfType(OrcaStream& os, OrcaStream::ChunkStream& cs)
     {
         [[maybe_unused]] auto t = cs.Read<EntityType>();
@@ -2516,6 +2641,8 @@ namespace OpenRCT2
 void ParkFileExporter::Export(std::string_view path)
 {
     auto parkFile = std::make_unique<OpenRCT2::ParkFile>();
+    parkFile->Compression = Compression;
+    parkFile->CompressionLevel = CompressionLevel;
     parkFile->Save(path);
 }
 
@@ -2523,9 +2650,29 @@ void ParkFileExporter::Export(IStream& stream)
 {
     auto parkFile = std::make_unique<OpenRCT2::ParkFile>();
     parkFile->ExportObjectsList = ExportObjectsList;
+    parkFile->Compression = Compression;
+    parkFile->CompressionLevel = CompressionLevel;
     parkFile->Save(stream);
 }
 
+ParkFileExporter::ParkFileExporter() = default;
+ParkFileExporter::~ParkFileExporter() = default;
+
+void ParkFileExporter::BeginExport(IStream& stream)
+{
+    _parkFile = std::make_unique<OpenRCT2::ParkFile>();
+    _parkFile->ExportObjectsList = ExportObjectsList;
+    _parkFile->Compression = Compression;
+    _parkFile->CompressionLevel = CompressionLevel;
+    _parkFile->BeginSave(stream, true);
+}
+
+void ParkFileExporter::FinishExport()
+{
+    auto parkFile = std::move(_parkFile);
+    parkFile->FinishSave();
+}
+
 enum : uint32_t
 {
     S6_SAVE_FLAG_EXPORT = 1 << 0,
@@ -2562,6 +2709,15 @@ int32_t ScenarioSave(u8string_view path, int32_t flags)
             parkFile->ExportObjectsList = objManager.GetPackableObjects();
         }
         parkFile->OmitTracklessRides = true;
+        if (gConfigGeneral.ParallelSaveCompression)
+        {
+            parkFile->Compression = OrcaStream::COMPRESSION_GZIP_CHUNKED;
+        }
+        if (gIsAutosave && gConfigGeneral.FastSaveCompression)
+        {
+            parkFile->Compression = OrcaStream::COMPRESSION_ZSTD_CHUNKED;
+            parkFile->CompressionLevel = ZstdLevelFast;
+        }
         if (flags & S6_SAVE_FLAG_SCENARIO)
         {
             // s6exporter->SaveScenario(path);
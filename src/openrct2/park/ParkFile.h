@@ -1,6 +1,9 @@
 #pragma once
 
+#include "../core/OrcaStream.hpp"
+
 #include <cstdint>
+#include <memory>
 #include <string_view>
 #include <vector>
 
@@ -9,17 +12,21 @@ struct ObjectRepositoryItem;
 namespace OpenRCT2
 {
     // Current version that is saved.
-    constexpr uint32_t PARK_FILE_CURRENT_VERSION = 30;
+    constexpr uint32_t PARK_FILE_CURRENT_VERSION = 31;
 
     // The minimum version that is forwards compatible with the current version.
     constexpr uint32_t PARK_FILE_MIN_VERSION = 30;
 
+    // The minimum version that can read parks written with the chunked compression modes.
+    constexpr uint32_t PARK_FILE_CHUNKED_MIN_VERSION = 31;
+
     // The minimum version that is backwards compatible with the current version.
     // If this is increased beyond 0, uncomment the checks in ParkFile.cpp and Context.cpp!
     constexpr uint32_t PARK_FILE_MIN_SUPPORTED_VERSION = 0x0;
 
     constexpr uint32_t PARK_FILE_MAGIC = 0x4B524150; // PARK
 
+    class ParkFile;
     struct IStream;
 } // namespace OpenRCT2
 
@@ -27,7 +34,23 @@ class ParkFileExporter
 {
 public:
     std::vector<const ObjectRepositoryItem*> ExportObjectsList;
+    uint32_t Compression = OpenRCT2::OrcaStream::COMPRESSION_GZIP;
+    int32_t CompressionLevel = GzipLevelDefault;
+
+    ParkFileExporter();
+    ~ParkFileExporter();
 
     void Export(std::string_view path);
     void Export(OpenRCT2::IStream& stream);
+
+    /**
+     * Exports the park in two steps. BeginExport writes all but the map and entities and copies those, FinishExport
+     * writes the copies and completes the park. FinishExport does not touch the game state, so it can run on another
+     * thread while the game goes on.
+     */
+    void BeginExport(OpenRCT2::IStream& stream);
+    void FinishExport();
+
+private:
+    std::unique_ptr<OpenRCT2::ParkFile> _parkFile;
 };
@@ -13,6 +13,7 @@
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <map>
 #include <stack>
 
 namespace OpenRCT2::Profiling
@@ -44,17 +45,115 @@ namespace OpenRCT2::Profiling
             FunctionInternal* Parent;
             FunctionInternal* Func;
             Tp EntryTime;
+            bool Traced;
 
-            FunctionEntry(FunctionInternal* parent, FunctionInternal* func, const Tp& entryTime)
+            FunctionEntry(FunctionInternal* parent, FunctionInternal* func, const Tp& entryTime, bool traced)
                 : Parent(parent)
                 , Func(func)
                 , EntryTime(entryTime)
+                , Traced(traced)
             {
             }
         };
 
         static thread_local std::stack<FunctionEntry> _callStack;
 
+        struct TraceEvent
+        {
+            const FunctionInternal* Func;
+            Tp Time;
+            bool Begin;
+        };
+
+        // Events are collected per thread and written out in batches so the threads
+        // only contend on the file when a buffer is flushed.
+        struct TraceBuffer
+        {
+            static constexpr size_t MaxPendingEvents = 4096;
+
+            uint32_t Session{};
+            uint32_t ThreadId;
+            std::vector<TraceEvent> Events;
+
+            TraceBuffer();
+            ~TraceBuffer();
+        };
+
+        static std::mutex _traceMutex;
+        static std::ofstream _traceStream;
+        static bool _traceHasEvents = false;
+        static Tp _traceStartTime;
+        static std::atomic<bool> _tracing{ false };
+        static std::atomic<uint32_t> _traceSession{ 0 };
+        static std::atomic<uint32_t> _traceNextThreadId{ 1 };
+
+        static thread_local TraceBuffer _traceBuffer;
+
+        static void WriteTraceString(std::ostream& out, const char* str)
+        {
+            out << '"';
+            for (; *str != '\0'; str++)
+            {
+                const auto c = *str;
+                if (c == '"' || c == '\\')
+                    out << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    out << ' ';
+                else
+                    out << c;
+            }
+            out << '"';
+        }
+
+        static void FlushTraceBuffer(TraceBuffer& buffer)
+        {
+            if (buffer.Events.empty())
+                return;
+
+            std::scoped_lock lock(_traceMutex);
+
+            // Events recorded for a previous trace are dropped.
+            if (_traceStream.is_open() && buffer.Session == _traceSession.load())
+            {
+                for (const auto& ev : buffer.Events)
+                {
+                    const auto deltaTime = ev.Time - _traceStartTime;
+                    const auto timeUs = std::chrono::duration_cast<std::chrono::nanoseconds>(deltaTime).count()
+                        / 1000.0;
+
+                    _traceStream << (_traceHasEvents ? ",\n" : "") << "{\"name\":";
+                    WriteTraceString(_traceStream, ev.Func->GetName());
+                    _traceStream << ",\"ph\":\"" << (ev.Begin ? 'B' : 'E') << "\",\"ts\":" << timeUs
+                                 << ",\"pid\":1,\"tid\":" << buffer.ThreadId << "}";
+                    _traceHasEvents = true;
+                }
+            }
+
+            buffer.Events.clear();
+        }
+
+        TraceBuffer::TraceBuffer()
+            : ThreadId(_traceNextThreadId++)
+        {
+        }
+
+        TraceBuffer::~TraceBuffer()
+        {
+            FlushTraceBuffer(*this);
+        }
+
+        static void RecordTraceEvent(const FunctionInternal& func, const Tp& time, bool begin)
+        {
+            const auto session = _traceSession.load();
+            if (_traceBuffer.Session != session)
+            {
+                _traceBuffer.Events.clear();
+                _traceBuffer.Session = session;
+            }
+
+            _traceBuffer.Events.push_back({ &func, time, begin });
+        }
+
         void FunctionEnter(Function& func)
         {
             const auto entryTime = Clock::now();
@@ -67,7 +166,11 @@ namespace OpenRCT2::Profiling
             if (!_callStack.empty())
                 parent = _callStack.top().Func;
 
-            _callStack.emplace(parent, &funcInternal, entryTime);
+            const bool traced = _tracing.load();
+            if (traced)
+                RecordTraceEvent(funcInternal, entryTime, true);
+
+            _callStack.emplace(parent, &funcInternal, entryTime, traced);
         }
 
         void FunctionExit(Function& func)
@@ -111,7 +214,18 @@ namespace OpenRCT2::Profiling
                 funcData->TotalTimeUs += elapsedTimeUs;
             }
 
+            // Only emit the end event if the matching begin event is part of the trace.
+            if (stackEntry.Traced && _tracing)
+            {
+                RecordTraceEvent(*funcData, exitTime, false);
+            }
+
             _callStack.pop();
+
+            if (_callStack.empty() || _traceBuffer.Events.size() >= TraceBuffer::MaxPendingEvents)
+            {
+                FlushTraceBuffer(_traceBuffer);
+            }
         }
 
         std::vector<Function*>& GetRegistry()
@@ -120,8 +234,72 @@ namespace OpenRCT2::Profiling
             return Registry;
         }
 
+        static std::mutex _counterMutex;
+        static std::map<std::string, Counter, std::less<>> _counters;
+
+        static void RecordTraceCounter(const char* name, int64_t value)
+        {
+            const auto time = Clock::now();
+
+            std::scoped_lock lock(_traceMutex);
+            if (!_traceStream.is_open())
+                return;
+
+            const auto timeUs = std::chrono::duration_cast<std::chrono::nanoseconds>(time - _traceStartTime).count()
+                / 1000.0;
+
+            _traceStream << (_traceHasEvents ? ",\n" : "") << "{\"name\":";
+            WriteTraceString(_traceStream, name);
+            _traceStream << ",\"ph\":\"C\",\"ts\":" << timeUs << ",\"pid\":1,\"args\":{\"value\":" << value << "}}";
+            _traceHasEvents = true;
+        }
+
     } // namespace Detail
 
+    void SetCounter(const char* name, int64_t value)
+    {
+        using namespace Detail;
+
+        if (!IsEnabled())
+            return;
+
+        {
+            std::scoped_lock lock(_counterMutex);
+
+            auto it = _counters.find(name);
+            if (it == _counters.end())
+            {
+                it = _counters.emplace(name, Counter{ name, value, value, value, 0 }).first;
+            }
+
+            auto& counter = it->second;
+            counter.Value = value;
+            counter.MinValue = std::min(counter.MinValue, value);
+            counter.MaxValue = std::max(counter.MaxValue, value);
+            counter.Samples++;
+        }
+
+        if (_tracing)
+        {
+            RecordTraceCounter(name, value);
+        }
+    }
+
+    std::vector<Counter> GetCounters()
+    {
+        using namespace Detail;
+
+        std::scoped_lock lock(_counterMutex);
+
+        std::vector<Counter> result;
+        result.reserve(_counters.size());
+        for (const auto& [name, counter] : _counters)
+        {
+            result.push_back(counter);
+        }
+        return result;
+    }
+
     const std::vector<Function*>& GetData()
     {
         return Detail::GetRegistry();
@@ -137,10 +315,14 @@ namespace OpenRCT2::Profiling
             funcInternal->CallCount = 0;
             funcInternal->MinTimeUs = 0.0;
             funcInternal->MaxTimeUs = 0.0;
+            funcInternal->TotalTimeUs = 0.0;
             funcInternal->SampleIterator = 0;
             funcInternal->Children.clear();
             funcInternal->Parents.clear();
         }
+
+        std::scoped_lock lock(Detail::_counterMutex);
+        Detail::_counters.clear();
     }
 
     bool ExportCSV(const std::string& filePath)
@@ -171,4 +353,55 @@ namespace OpenRCT2::Profiling
         return true;
     }
 
+    bool StartTrace(const std::string& filePath)
+    {
+        using namespace Detail;
+
+        StopTrace();
+
+        {
+            std::scoped_lock lock(_traceMutex);
+
+            _traceStream.open(filePath, std::ios::out | std::ios::trunc);
+            if (!_traceStream.is_open())
+                return false;
+
+            // JSON Array Format, the closing bracket is optional so the file remains
+            // readable if the process terminates without stopping the trace.
+            _traceStream << "[\n";
+            _traceStream << std::setprecision(3) << std::fixed;
+            _traceHasEvents = false;
+            _traceStartTime = Clock::now();
+            _traceSession++;
+            _tracing = true;
+        }
+
+        Enable();
+        return true;
+    }
+
+    void StopTrace()
+    {
+        using namespace Detail;
+
+        if (!_tracing)
+            return;
+
+        FlushTraceBuffer(_traceBuffer);
+
+        std::scoped_lock lock(_traceMutex);
+        _tracing = false;
+        _traceSession++;
+        if (_traceStream.is_open())
+        {
+            _traceStream << "\n]\n";
+            _traceStream.close();
+        }
+    }
+
+    bool IsTracing()
+    {
+        return Detail::_tracing;
+    }
+
 } // namespace OpenRCT2::Profiling
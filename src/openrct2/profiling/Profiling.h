@@ -182,7 +182,29 @@ namespace OpenRCT2::Profiling
         }
     };
 
-    // Clears all the current data of each function.
+    struct Counter
+    {
+        std::string Name;
+
+        // Most recently recorded value.
+        int64_t Value{};
+
+        int64_t MinValue{};
+
+        int64_t MaxValue{};
+
+        // Number of values recorded.
+        uint64_t Samples{};
+    };
+
+    // Records the current value of a named counter such as the size of a pool, this does nothing
+    // unless the profiler is enabled. While tracing, the value is also written as a counter event.
+    void SetCounter(const char* name, int64_t value);
+
+    // Returns all counters sorted by name.
+    std::vector<Counter> GetCounters();
+
+    // Clears all the current data of each function and counter.
     void ResetData();
 
     // Returns all functions.
@@ -190,4 +212,13 @@ namespace OpenRCT2::Profiling
 
     bool ExportCSV(const std::string& filePath);
 
+    // Starts streaming begin/end events of profiled functions per thread to a file in the
+    // Chrome Trace Event format, this also enables the profiler.
+    bool StartTrace(const std::string& filePath);
+
+    // Flushes the pending events of the calling thread and closes the trace file.
+    void StopTrace();
+
+    bool IsTracing();
+
 } // namespace OpenRCT2::Profiling
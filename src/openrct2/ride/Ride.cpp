@@ -201,6 +201,7 @@ void RideDelete(RideId id)
     assert(_rides[idx].type != RIDE_TYPE_NULL);
 
     auto& ride = _rides[idx];
+    Park::OnRideRemoved(ride);
     RideReset(ride);
 
     // Shrink maximum ride size.
@@ -943,6 +944,7 @@ void RideInitAll()
 {
     std::for_each(std::begin(_rides), std::end(_rides), RideReset);
     _endOfUsedRange = 0;
+    Park::ResetRideTotals();
 }
 
 /**
@@ -1105,6 +1107,7 @@ void Ride::Update()
             num_customers[i] = num_customers[i - 1];
         }
         num_customers[0] = cur_num_customers;
+        Park::OnRideChanged(*this);
 
         cur_num_customers = 0;
         window_invalidate_flags |= RIDE_INVALIDATE_RIDE_CUSTOMER;
@@ -1396,6 +1399,7 @@ static void RideBreakdownUpdate(Ride& ride)
         }
 
         ride.downtime = std::min(totalDowntime / 2, 100);
+        Park::OnRideChanged(ride);
 
         for (int32_t i = OpenRCT2::Limits::DowntimeHistorySize - 1; i > 0; i--)
         {
@@ -4603,6 +4607,7 @@ void InvalidateTestResults(Ride& ride)
 {
     ride.measurement = {};
     ride.excitement = RIDE_RATING_UNDEFINED;
+    Park::OnRideChanged(ride);
     ride.lifecycle_flags &= ~RIDE_LIFECYCLE_TESTED;
     ride.lifecycle_flags &= ~RIDE_LIFECYCLE_TEST_IN_PROGRESS;
     if (ride.lifecycle_flags & RIDE_LIFECYCLE_ON_TRACK)
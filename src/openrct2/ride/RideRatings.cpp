@@ -18,6 +18,7 @@
 #include "../scripting/ScriptEngine.h"
 #include "../world/Footpath.h"
 #include "../world/Map.h"
+#include "../world/Park.h"
 #include "../world/Surface.h"
 #include "Ride.h"
 #include "RideData.h"
@@ -432,6 +433,7 @@ static void ride_ratings_update_state_3(RideRatingUpdateState& state)
 
     RideRatingsCalculate(state, *ride);
     RideRatingsCalculateValue(*ride);
+    Park::OnRideChanged(*ride);
 
     WindowInvalidateByNumber(WindowClass::Ride, state.CurrentRide.ToUnderlying());
     state.State = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
@@ -9,9 +9,9 @@
 #pragma once
 
 #include "../Identifiers.h"
+#include "../entity/EntityIdSet.h"
 
 #include <cstdint>
-#include <list>
 
 struct Vehicle;
 
@@ -21,17 +21,17 @@ namespace TrainManager
     class View
     {
     private:
-        const std::list<EntityId>* vec;
+        const EntityIdSet* vec;
 
         class Iterator
         {
         private:
-            std::list<EntityId>::const_iterator iter;
-            std::list<EntityId>::const_iterator end;
+            EntityIdSet::Iterator iter;
+            EntityIdSet::Iterator end;
             Vehicle* Entity = nullptr;
 
         public:
-            Iterator(std::list<EntityId>::const_iterator _iter, std::list<EntityId>::const_iterator _end)
+            Iterator(EntityIdSet::Iterator _iter, EntityIdSet::Iterator _end)
                 : iter(_iter)
                 , end(_end)
             {
@@ -164,6 +164,8 @@ namespace OpenRCT2::Scripting
             }
             obj.Set("bytesSent", DukValue::take_from_stack(_context));
         }
+        obj.Set("sendFlushes", networkStats.sendFlushes);
+        obj.Set("sendSyscalls", networkStats.sendSyscalls);
         return obj.Take();
 #    else
         return ToDuk(_context, nullptr);
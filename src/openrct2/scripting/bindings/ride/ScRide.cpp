@@ -15,6 +15,7 @@
 #    include "../../../common.h"
 #    include "../../../ride/Ride.h"
 #    include "../../../ride/RideData.h"
+#    include "../../../world/Park.h"
 #    include "../../Duktape.hpp"
 #    include "../../ScriptEngine.h"
 #    include "../object/ScObject.hpp"
@@ -342,6 +343,7 @@ namespace OpenRCT2::Scripting
         if (ride != nullptr)
         {
             ride->excitement = value;
+            Park::OnRideChanged(*ride);
         }
     }
 
@@ -357,6 +359,7 @@ namespace OpenRCT2::Scripting
         if (ride != nullptr)
         {
             ride->intensity = value;
+            Park::OnRideChanged(*ride);
         }
     }
 
@@ -481,6 +484,7 @@ namespace OpenRCT2::Scripting
             {
                 ride->value = RIDE_VALUE_UNDEFINED;
             }
+            Park::OnRideChanged(*ride);
         }
     }
 
@@ -11,6 +11,8 @@
 
 #include "../common.h"
 #include "../core/Guard.hpp"
+#include "../core/IStream.hpp"
+#include "../core/JobPool.h"
 #include "../core/Path.hpp"
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
@@ -18,11 +20,18 @@
 #include "../title/TitleScreen.h"
 #include "zlib.h"
 
+#include <zstd.h>
+
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
+#include <cstring>
 #include <ctime>
+#include <limits>
+#include <memory>
 #include <random>
+#include <stdexcept>
 
 int32_t SquaredMetresToSquaredFeet(int32_t squaredMetres)
 {
@@ -79,6 +88,14 @@ int32_t UtilBitScanForward(int64_t source)
     DWORD i;
     uint8_t success = _BitScanForward64(&i, static_cast<uint64_t>(source));
     return success != 0 ? i : -1;
+#elif defined(_MSC_VER) && (_MSC_VER >= 1400)
+    // _BitScanForward64 is only available on 64-bit targets, scan the two halves instead.
+    DWORD i;
+    if (_BitScanForward(&i, static_cast<uint32_t>(source)) != 0)
+        return i;
+    if (_BitScanForward(&i, static_cast<uint32_t>(static_cast<uint64_t>(source) >> 32)) != 0)
+        return i + 32;
+    return -1;
 #elif defined(__GNUC__)
     int32_t success = __builtin_ffsll(source);
     return success - 1;
@@ -406,7 +423,7 @@ bool UtilGzipCompress(FILE* source, FILE* dest)
     return true;
 }
 
-std::vector<uint8_t> Gzip(const void* data, const size_t dataLen)
+std::vector<uint8_t> Gzip(const void* data, const size_t dataLen, const int32_t level)
 {
     assert(data != nullptr);
 
@@ -417,7 +434,7 @@ std::vector<uint8_t> Gzip(const void* data, const size_t dataLen)
     strm.opaque = Z_NULL;
 
     {
-        const auto ret = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | 16, 8, Z_DEFAULT_STRATEGY);
+        const auto ret = deflateInit2(&strm, level, Z_DEFLATED, 15 | 16, 8, Z_DEFAULT_STRATEGY);
         if (ret != Z_OK)
         {
             throw std::runtime_error("deflateInit2 failed with error " + std::to_string(ret));
@@ -502,6 +519,340 @@ std::vector<uint8_t> Ungzip(const void* data, const size_t dataLen)
     return output;
 }
 
+struct GzipStreamReader::State
+{
+    OpenRCT2::IStream& Stream;
+    // Where the compressed data not yet read starts in the stream, and how much of it is left.
+    uint64_t Position{};
+    uint64_t Remaining{};
+    z_stream Strm{};
+    std::vector<uint8_t> Input;
+    bool Finished{};
+};
+
+GzipStreamReader::GzipStreamReader(OpenRCT2::IStream& stream, const uint64_t dataLen)
+    : _state(std::make_unique<State>(State{ stream, stream.GetPosition(), dataLen }))
+{
+    const auto ret = inflateInit2(&_state->Strm, 15 | 16);
+    if (ret != Z_OK)
+    {
+        throw std::runtime_error("inflateInit2 failed with error " + std::to_string(ret));
+    }
+    _state->Input.resize(64 * 1024);
+}
+
+GzipStreamReader::~GzipStreamReader()
+{
+    inflateEnd(&_state->Strm);
+}
+
+size_t GzipStreamReader::Read(void* dst, const size_t len)
+{
+    auto& state = *_state;
+    auto& strm = state.Strm;
+    strm.next_out = static_cast<Bytef*>(dst);
+    strm.avail_out = static_cast<uInt>(std::min<size_t>(len, std::numeric_limits<uInt>::max()));
+    const auto outLen = strm.avail_out;
+    while (strm.avail_out > 0 && !state.Finished)
+    {
+        if (strm.avail_in == 0)
+        {
+            if (state.Remaining == 0)
+            {
+                throw std::runtime_error("Gzip data is truncated");
+            }
+            const auto readLen = static_cast<size_t>(std::min<uint64_t>(state.Remaining, state.Input.size()));
+            state.Stream.SetPosition(state.Position);
+            state.Stream.Read(state.Input.data(), readLen);
+            state.Position += readLen;
+            state.Remaining -= readLen;
+            strm.next_in = state.Input.data();
+            strm.avail_in = static_cast<uInt>(readLen);
+        }
+
+        const auto ret = inflate(&strm, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END)
+        {
+            state.Finished = true;
+        }
+        else if (ret != Z_OK)
+        {
+            throw std::runtime_error("inflate failed with error " + std::to_string(ret));
+        }
+    }
+    return outLen - strm.avail_out;
+}
+
+#pragma pack(push, 1)
+struct GzipChunkedHeader
+{
+    uint64_t UncompressedSize;
+    uint32_t BlockSize;
+    uint32_t NumBlocks;
+};
+#pragma pack(pop)
+
+// Upper bound for the block size of chunked data, so a corrupt header can not make us allocate absurd amounts.
+constexpr size_t GZIP_CHUNKED_MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+// Deflate can not compress data to less than about 1/1032 of its size, chunked data claiming to hold more is corrupt.
+constexpr uint64_t GZIP_CHUNKED_MAX_RATIO = 1032;
+// A Zstandard block of up to 128 KiB takes at least 4 bytes.
+constexpr uint64_t ZSTD_CHUNKED_MAX_RATIO = 32 * 1024;
+
+using ChunkedCompressFunc = std::vector<uint8_t> (*)(const void* data, const size_t dataLen, const int32_t level);
+
+static std::vector<uint8_t> CompressChunked(
+    const void* data, const size_t dataLen, const int32_t level, const size_t blockSize, ChunkedCompressFunc compress)
+{
+    assert(data != nullptr || dataLen == 0);
+    assert(blockSize > 0 && blockSize <= GZIP_CHUNKED_MAX_BLOCK_SIZE);
+
+    const auto numBlocks = (dataLen + blockSize - 1) / blockSize;
+    if (numBlocks > UINT32_MAX)
+    {
+        throw std::runtime_error("Too much data to compress");
+    }
+
+    std::vector<std::vector<uint8_t>> blocks(numBlocks);
+    std::atomic<bool> failed{ false };
+    JobPool::GetShared().ParallelFor(numBlocks, [&](size_t i) {
+        const auto* src = static_cast<const uint8_t*>(data) + i * blockSize;
+        try
+        {
+            blocks[i] = compress(src, std::min(blockSize, dataLen - i * blockSize), level);
+        }
+        catch (const std::exception&)
+        {
+            failed = true;
+        }
+    });
+    if (failed)
+    {
+        throw std::runtime_error("Failed to compress block");
+    }
+
+    GzipChunkedHeader header{};
+    header.UncompressedSize = dataLen;
+    header.BlockSize = static_cast<uint32_t>(blockSize);
+    header.NumBlocks = static_cast<uint32_t>(numBlocks);
+
+    size_t outputSize = sizeof(header) + numBlocks * sizeof(uint32_t);
+    for (const auto& block : blocks)
+    {
+        outputSize += block.size();
+    }
+
+    std::vector<uint8_t> output(outputSize);
+    auto* dst = output.data();
+    std::memcpy(dst, &header, sizeof(header));
+    dst += sizeof(header);
+    for (const auto& block : blocks)
+    {
+        const auto compressedSize = static_cast<uint32_t>(block.size());
+        std::memcpy(dst, &compressedSize, sizeof(compressedSize));
+        dst += sizeof(compressedSize);
+    }
+    for (const auto& block : blocks)
+    {
+        std::memcpy(dst, block.data(), block.size());
+        dst += block.size();
+    }
+    return output;
+}
+
+// Compresses a block as a single Zstandard frame, each thread keeps its own context. The frame carries a checksum
+// so damaged data is caught like it is by the CRC of a gzip member.
+static std::vector<uint8_t> ZstdBlock(const void* data, const size_t dataLen, const int32_t level)
+{
+    static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    if (context == nullptr)
+    {
+        throw std::runtime_error("ZSTD_createCCtx failed");
+    }
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, level);
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_checksumFlag, 1);
+
+    std::vector<uint8_t> output(ZSTD_compressBound(dataLen));
+    const auto size = ZSTD_compress2(context.get(), output.data(), output.size(), data, dataLen);
+    if (ZSTD_isError(size))
+    {
+        throw std::runtime_error(std::string("ZSTD_compress2 failed with error ") + ZSTD_getErrorName(size));
+    }
+    output.resize(size);
+    return output;
+}
+
+std::vector<uint8_t> GzipChunked(const void* data, const size_t dataLen, const int32_t level, const size_t blockSize)
+{
+    return CompressChunked(data, dataLen, level, blockSize, Gzip);
+}
+
+std::vector<uint8_t> ZstdChunked(const void* data, const size_t dataLen, const int32_t level, const size_t blockSize)
+{
+    return CompressChunked(data, dataLen, level, blockSize, ZstdBlock);
+}
+
+// Decompresses a single gzip member that must fill the destination exactly.
+static bool UngzipBlock(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen)
+{
+    z_stream strm{};
+    if (inflateInit2(&strm, 15 | 16) != Z_OK)
+    {
+        return false;
+    }
+
+    strm.avail_in = static_cast<uInt>(srcLen);
+    strm.next_in = const_cast<Bytef*>(src);
+    strm.avail_out = static_cast<uInt>(dstLen);
+    strm.next_out = dst;
+    const auto ret = inflate(&strm, Z_FINISH);
+    const auto totalOut = strm.total_out;
+    inflateEnd(&strm);
+    return ret == Z_STREAM_END && totalOut == dstLen;
+}
+
+// Decompresses a single Zstandard frame that must fill the destination exactly.
+static bool UnzstdBlock(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen)
+{
+    static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    if (context == nullptr)
+    {
+        return false;
+    }
+
+    const auto size = ZSTD_decompressDCtx(context.get(), dst, dstLen, src, srcLen);
+    return !ZSTD_isError(size) && size == dstLen;
+}
+
+static void ValidateChunkedHeader(
+    const GzipChunkedHeader& header, ChunkedCodec codec, uint64_t dataLen, uint64_t maxUncompressedSize)
+{
+    const auto tableSize = static_cast<uint64_t>(header.NumBlocks) * sizeof(uint32_t);
+    const auto expectedNumBlocks = header.BlockSize == 0
+        ? 0
+        : (header.UncompressedSize + header.BlockSize - 1) / header.BlockSize;
+    if (header.BlockSize == 0 || header.BlockSize > GZIP_CHUNKED_MAX_BLOCK_SIZE || header.NumBlocks != expectedNumBlocks
+        || sizeof(header) + tableSize > dataLen)
+    {
+        throw std::runtime_error("Chunked data has an invalid header");
+    }
+
+    // Checked before anything of that size is allocated.
+    const auto maxRatio = codec == ChunkedCodec::Zstd ? ZSTD_CHUNKED_MAX_RATIO : GZIP_CHUNKED_MAX_RATIO;
+    if (header.UncompressedSize > maxUncompressedSize || header.UncompressedSize / maxRatio > dataLen
+        || header.UncompressedSize > SIZE_MAX)
+    {
+        throw std::runtime_error("Chunked data has an invalid uncompressed size");
+    }
+}
+
+// Turns the table of member sizes that follows the header into member offsets.
+static ChunkedIndex CreateChunkedIndex(
+    const GzipChunkedHeader& header, ChunkedCodec codec, const uint8_t* table, uint64_t dataLen)
+{
+    ChunkedIndex index;
+    index.Codec = codec;
+    index.UncompressedSize = header.UncompressedSize;
+    index.BlockSize = header.BlockSize;
+    index.MemberOffsets.resize(header.NumBlocks + 1);
+    index.MemberOffsets[0] = sizeof(header) + static_cast<uint64_t>(header.NumBlocks) * sizeof(uint32_t);
+    for (uint32_t i = 0; i < header.NumBlocks; i++)
+    {
+        uint32_t compressedSize;
+        std::memcpy(&compressedSize, table + i * sizeof(uint32_t), sizeof(compressedSize));
+        index.MemberOffsets[i + 1] = index.MemberOffsets[i] + compressedSize;
+        if (index.MemberOffsets[i + 1] > dataLen)
+        {
+            throw std::runtime_error("Chunked data is truncated");
+        }
+    }
+    return index;
+}
+
+size_t ChunkedIndex::GetNumBlocks() const
+{
+    return MemberOffsets.empty() ? 0 : MemberOffsets.size() - 1;
+}
+
+size_t ChunkedIndex::GetBlockLength(size_t block) const
+{
+    return static_cast<size_t>(std::min<uint64_t>(BlockSize, UncompressedSize - static_cast<uint64_t>(block) * BlockSize));
+}
+
+size_t ChunkedIndex::GetMemberLength(size_t block) const
+{
+    return static_cast<size_t>(MemberOffsets[block + 1] - MemberOffsets[block]);
+}
+
+ChunkedIndex ChunkedReadIndex(
+    OpenRCT2::IStream& stream, const ChunkedCodec codec, const uint64_t dataLen, const uint64_t maxUncompressedSize)
+{
+    if (dataLen < sizeof(GzipChunkedHeader))
+    {
+        throw std::runtime_error("Chunked data is too short");
+    }
+    const auto header = stream.ReadValue<GzipChunkedHeader>();
+    ValidateChunkedHeader(header, codec, dataLen, maxUncompressedSize);
+
+    std::vector<uint8_t> table(header.NumBlocks * sizeof(uint32_t));
+    stream.Read(table.data(), table.size());
+    return CreateChunkedIndex(header, codec, table.data(), dataLen);
+}
+
+void DecompressChunkedBlock(const ChunkedIndex& index, const size_t block, const void* member, uint8_t* dst)
+{
+    const auto decompress = index.Codec == ChunkedCodec::Zstd ? UnzstdBlock : UngzipBlock;
+    if (!decompress(static_cast<const uint8_t*>(member), index.GetMemberLength(block), dst, index.GetBlockLength(block)))
+    {
+        throw std::runtime_error("Failed to decompress block");
+    }
+}
+
+static std::vector<uint8_t> DecompressChunked(
+    const void* data, const size_t dataLen, const ChunkedCodec codec, const uint64_t maxUncompressedSize)
+{
+    assert(data != nullptr || dataLen == 0);
+
+    GzipChunkedHeader header{};
+    if (dataLen < sizeof(header))
+    {
+        throw std::runtime_error("Chunked data is too short");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    ValidateChunkedHeader(header, codec, dataLen, maxUncompressedSize);
+
+    const auto* src = static_cast<const uint8_t*>(data);
+    const auto index = CreateChunkedIndex(header, codec, src + sizeof(header), dataLen);
+
+    std::vector<uint8_t> output(static_cast<size_t>(index.UncompressedSize));
+    std::atomic<bool> failed{ false };
+    JobPool::GetShared().ParallelFor(index.GetNumBlocks(), [&](size_t i) {
+        try
+        {
+            DecompressChunkedBlock(index, i, src + index.MemberOffsets[i], output.data() + i * index.BlockSize);
+        }
+        catch (const std::exception&)
+        {
+            failed = true;
+        }
+    });
+    if (failed)
+    {
+        throw std::runtime_error("Failed to decompress block");
+    }
+    return output;
+}
+
+std::vector<uint8_t> UngzipChunked(const void* data, const size_t dataLen, const uint64_t maxUncompressedSize)
+{
+    return DecompressChunked(data, dataLen, ChunkedCodec::Gzip, maxUncompressedSize);
+}
+
+std::vector<uint8_t> UnzstdChunked(const void* data, const size_t dataLen, const uint64_t maxUncompressedSize)
+{
+    return DecompressChunked(data, dataLen, ChunkedCodec::Zstd, maxUncompressedSize);
+}
+
 // Type-independent code left as macro to reduce duplicate code.
 #define ADD_CLAMP_BODY(value, value_to_add, min_cap, max_cap)                                                                  \
     if ((value_to_add > 0) && (value > (max_cap - (value_to_add))))                                                            \
@@ -14,10 +14,16 @@
 
 #include <cstdio>
 #include <ctime>
+#include <memory>
 #include <optional>
 #include <type_traits>
 #include <vector>
 
+namespace OpenRCT2
+{
+    struct IStream;
+}
+
 int32_t SquaredMetresToSquaredFeet(int32_t squaredMetres);
 int32_t MetresToFeet(int32_t metres);
 int32_t MphToKmph(int32_t mph);
@@ -36,10 +42,79 @@ char* SafeStrCat(char* destination, const char* source, size_t size);
 uint32_t UtilRand();
 float UtilRandNormalDistributed();
 
+// zlib compression levels, the fast level is for saves where time matters more than size, such as autosaves and maps
+// sent to joining clients.
+constexpr int32_t GzipLevelDefault = -1;
+constexpr int32_t GzipLevelFast = 1;
+
+// Zstandard compression levels.
+constexpr int32_t ZstdLevelDefault = 3;
+constexpr int32_t ZstdLevelFast = 1;
+
 bool UtilGzipCompress(FILE* source, FILE* dest);
-std::vector<uint8_t> Gzip(const void* data, const size_t dataLen);
+std::vector<uint8_t> Gzip(const void* data, const size_t dataLen, const int32_t level = GzipLevelDefault);
 std::vector<uint8_t> Ungzip(const void* data, const size_t dataLen);
 
+// Decompresses gzip data from a stream a piece at a time, so a reader that only needs the start of the data does not
+// read or decompress the rest. The stream has to stay open as long as the reader.
+class GzipStreamReader
+{
+public:
+    GzipStreamReader(OpenRCT2::IStream& stream, const uint64_t dataLen);
+    GzipStreamReader(const GzipStreamReader&) = delete;
+    ~GzipStreamReader();
+
+    // Decompresses up to len bytes into dst and returns how many were written, fewer than len only at the end of the
+    // data.
+    size_t Read(void* dst, const size_t len);
+
+private:
+    struct State;
+    std::unique_ptr<State> _state;
+};
+
+// How the members of chunked data are compressed.
+enum class ChunkedCodec : uint8_t
+{
+    Gzip,
+    Zstd,
+};
+
+// Compresses the data as independent gzip members of blockSize bytes each, in parallel. The output starts with a table
+// of the member sizes so UngzipChunked can decompress the members in parallel as well.
+std::vector<uint8_t> GzipChunked(
+    const void* data, const size_t dataLen, const int32_t level = GzipLevelDefault, const size_t blockSize = 256 * 1024);
+// Throws when the data claims to decompress to more than maxUncompressedSize bytes or more than deflate can compress
+// into dataLen bytes, before allocating the output.
+std::vector<uint8_t> UngzipChunked(const void* data, const size_t dataLen, const uint64_t maxUncompressedSize = UINT64_MAX);
+
+// The same as GzipChunked with Zstandard frames as members, which compress and decompress several times faster.
+std::vector<uint8_t> ZstdChunked(
+    const void* data, const size_t dataLen, const int32_t level = ZstdLevelDefault, const size_t blockSize = 256 * 1024);
+std::vector<uint8_t> UnzstdChunked(const void* data, const size_t dataLen, const uint64_t maxUncompressedSize = UINT64_MAX);
+
+// Where the members of chunked data are, so single blocks can be decompressed when they are needed.
+struct ChunkedIndex
+{
+    ChunkedCodec Codec{};
+    uint64_t UncompressedSize{};
+    uint32_t BlockSize{};
+    // Offsets of the members from the start of the chunked data, followed by the end of the last member.
+    std::vector<uint64_t> MemberOffsets;
+
+    size_t GetNumBlocks() const;
+    size_t GetBlockLength(size_t block) const;
+    size_t GetMemberLength(size_t block) const;
+};
+
+// Reads the header and member table of chunked data from the stream, the members themselves are not read. The size
+// limits are the same as the ones of UngzipChunked.
+ChunkedIndex ChunkedReadIndex(
+    OpenRCT2::IStream& stream, const ChunkedCodec codec, const uint64_t dataLen,
+    const uint64_t maxUncompressedSize = UINT64_MAX);
+// Decompresses one member, the destination must have room for the length of its block.
+void DecompressChunkedBlock(const ChunkedIndex& index, const size_t block, const void* member, uint8_t* dst);
+
 // TODO: Make these specialized template functions, or when possible Concepts in C++20
 int8_t AddClamp_int8_t(int8_t value, int8_t value_to_add);
 int16_t AddClamp_int16_t(int16_t value, int16_t value_to_add);
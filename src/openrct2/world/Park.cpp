@@ -42,6 +42,7 @@
 #include "Surface.h"
 
 #include <algorithm>
+#include <array>
 #include <limits>
 
 using namespace OpenRCT2;
@@ -79,6 +80,39 @@ uint32_t _suggestedGuestMaximum;
  */
 int32_t _guestGenerationProbability;
 
+// What a single ride adds to the ride part of the park rating and to the park value.
+struct RideParkContribution
+{
+    bool Counted{};
+    bool HasRatings{};
+    int32_t Uptime{};
+    int32_t Excitement{};
+    int32_t Intensity{};
+    money64 Value{};
+};
+
+struct RideParkTotals
+{
+    int32_t RideCount{};
+    int32_t ExcitingRideCount{};
+    int32_t Uptime{};
+    int32_t Excitement{};
+    int32_t Intensity{};
+    money64 Value{};
+
+    bool operator==(const RideParkTotals& other) const
+    {
+        return RideCount == other.RideCount && ExcitingRideCount == other.ExcitingRideCount && Uptime == other.Uptime
+            && Excitement == other.Excitement && Intensity == other.Intensity && Value == other.Value;
+    }
+};
+
+// Running sums over every ride, kept up to date by the ride hooks so the park rating and value do not have to visit
+// every ride each time. Rebuilt from the rides on the next query whenever _rideParkTotalsValid is false.
+static std::array<RideParkContribution, Limits::MaxRidesInPark> _rideParkContributions;
+static RideParkTotals _rideParkTotals;
+static bool _rideParkTotalsValid;
+
 /**
  * Choose a random peep spawn and iterates through until defined spawn is found.
  */
@@ -363,6 +397,80 @@ uint32_t Park::CalculateParkSize() const
     return tiles;
 }
 
+static money64 CalculateRideValue(const Ride& ride)
+{
+    money64 result = 0;
+    if (ride.value != RIDE_VALUE_UNDEFINED)
+    {
+        const auto& rtd = ride.GetRideTypeDescriptor();
+        result = (ride.value * 10) * (static_cast<money64>(RideCustomersInLast5Minutes(ride)) + rtd.BonusValue * 4LL);
+    }
+    return result;
+}
+
+static RideParkContribution GetRideParkContribution(const Ride& ride)
+{
+    RideParkContribution result;
+    result.Counted = true;
+    result.Uptime = 100 - ride.downtime;
+    if (RideHasRatings(ride))
+    {
+        result.HasRatings = true;
+        result.Excitement = ride.excitement / 8;
+        result.Intensity = ride.intensity / 8;
+    }
+    result.Value = CalculateRideValue(ride);
+    return result;
+}
+
+static void AddRideParkContribution(RideParkTotals& totals, const RideParkContribution& contribution, int32_t sign)
+{
+    totals.RideCount += sign;
+    if (contribution.HasRatings)
+    {
+        totals.ExcitingRideCount += sign;
+        totals.Excitement += sign * contribution.Excitement;
+        totals.Intensity += sign * contribution.Intensity;
+    }
+    totals.Uptime += sign * contribution.Uptime;
+    totals.Value += sign * contribution.Value;
+}
+
+static void RebuildRideParkTotals()
+{
+    _rideParkContributions.fill({});
+    _rideParkTotals = {};
+    for (const auto& ride : GetRideManager())
+    {
+        auto& contribution = _rideParkContributions[ride.id.ToUnderlying()];
+        contribution = GetRideParkContribution(ride);
+        AddRideParkContribution(_rideParkTotals, contribution, 1);
+    }
+    _rideParkTotalsValid = true;
+}
+
+static const RideParkTotals& GetRideParkTotals()
+{
+    if (!_rideParkTotalsValid)
+    {
+        RebuildRideParkTotals();
+    }
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    // Cross-check against summing every ride.
+    RideParkTotals expectedTotals;
+    for (const auto& ride : GetRideManager())
+    {
+        AddRideParkContribution(expectedTotals, GetRideParkContribution(ride), 1);
+    }
+    if (!(_rideParkTotals == expectedTotals))
+    {
+        LOG_ERROR("Ride totals for the park rating and value are out of date. Rebuilding.");
+        RebuildRideParkTotals();
+    }
+#endif
+    return _rideParkTotals;
+}
+
 int32_t Park::CalculateParkRating() const
 {
     if (_forcedParkRating >= 0)
@@ -415,22 +523,12 @@ int32_t Park::CalculateParkRating() const
 
     // Rides
     {
-        int32_t rideCount = 0;
-        int32_t excitingRideCount = 0;
-        int32_t totalRideUptime = 0;
-        int32_t totalRideIntensity = 0;
-        int32_t totalRideExcitement = 0;
-        for (auto& ride : GetRideManager())
-        {
-            totalRideUptime += 100 - ride.downtime;
-            if (RideHasRatings(ride))
-            {
-                totalRideExcitement += ride.excitement / 8;
-                totalRideIntensity += ride.intensity / 8;
-                excitingRideCount++;
-            }
-            rideCount++;
-        }
+        const auto& rideTotals = GetRideParkTotals();
+        const int32_t rideCount = rideTotals.RideCount;
+        const int32_t excitingRideCount = rideTotals.ExcitingRideCount;
+        const int32_t totalRideUptime = rideTotals.Uptime;
+        int32_t totalRideIntensity = rideTotals.Intensity;
+        int32_t totalRideExcitement = rideTotals.Excitement;
         result -= 200;
         if (rideCount > 0)
         {
@@ -467,9 +565,7 @@ int32_t Park::CalculateParkRating() const
     // Litter
     {
         // Counts the amount of litter whose age is min. 7680 ticks (5~ min) old.
-        const auto litterList = EntityList<Litter>();
-        const auto litterCount = std::count_if(
-            litterList.begin(), litterList.end(), [](auto* litter) { return litter->GetAge() >= 7680; });
+        const auto litterCount = Litter::GetAgedCount();
 
         result -= 600 - (4 * (150 - std::min<int32_t>(150, litterCount)));
     }
@@ -482,11 +578,7 @@ int32_t Park::CalculateParkRating() const
 money64 Park::CalculateParkValue() const
 {
     // Sum ride values
-    money64 result = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        result += CalculateRideValue(ride);
-    }
+    money64 result = GetRideParkTotals().Value;
 
     // +7.00 per guest
     result += static_cast<money64>(gNumGuestsInPark) * 7.00_GBP;
@@ -494,15 +586,37 @@ money64 Park::CalculateParkValue() const
     return result;
 }
 
-money64 Park::CalculateRideValue(const Ride& ride) const
+void Park::OnRideChanged(const Ride& ride)
 {
-    money64 result = 0;
-    if (ride.value != RIDE_VALUE_UNDEFINED)
+    // The preview ride used by track designs is not part of the park.
+    if (!_rideParkTotalsValid || GetRide(ride.id) != &ride)
+        return;
+
+    auto& contribution = _rideParkContributions[ride.id.ToUnderlying()];
+    if (contribution.Counted)
     {
-        const auto& rtd = ride.GetRideTypeDescriptor();
-        result = (ride.value * 10) * (static_cast<money64>(RideCustomersInLast5Minutes(ride)) + rtd.BonusValue * 4LL);
+        AddRideParkContribution(_rideParkTotals, contribution, -1);
     }
-    return result;
+    contribution = GetRideParkContribution(ride);
+    AddRideParkContribution(_rideParkTotals, contribution, 1);
+}
+
+void Park::OnRideRemoved(const Ride& ride)
+{
+    if (!_rideParkTotalsValid || GetRide(ride.id) != &ride)
+        return;
+
+    auto& contribution = _rideParkContributions[ride.id.ToUnderlying()];
+    if (contribution.Counted)
+    {
+        AddRideParkContribution(_rideParkTotals, contribution, -1);
+    }
+    contribution = {};
+}
+
+void Park::ResetRideTotals()
+{
+    _rideParkTotalsValid = false;
 }
 
 money64 Park::CalculateCompanyValue() const
@@ -76,13 +76,21 @@ namespace OpenRCT2
         money64 CalculateCompanyValue() const;
         static uint8_t CalculateGuestInitialHappiness(uint8_t percentage);
 
+        /**
+         * Keep the ride totals behind CalculateParkRating and CalculateParkValue up to date. OnRideChanged must be
+         * called after the downtime, ratings, value, customer history or type of a ride change, OnRideRemoved before
+         * a ride is deleted and ResetRideTotals when every ride is replaced.
+         */
+        static void OnRideChanged(const Ride& ride);
+        static void OnRideRemoved(const Ride& ride);
+        static void ResetRideTotals();
+
         Guest* GenerateGuest();
 
         void ResetHistories();
         void UpdateHistories();
 
     private:
-        money64 CalculateRideValue(const Ride& ride) const;
         money64 CalculateTotalRideValueForMoney() const;
         uint32_t CalculateSuggestedMaxGuests() const;
         uint32_t CalculateGuestGenerationProbability() const;
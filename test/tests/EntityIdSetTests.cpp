@@ -0,0 +1,126 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/entity/EntityIdSet.h>
+#include <random>
+#include <set>
+#include <vector>
+
+static EntityId MakeId(uint16_t id)
+{
+    return EntityId::FromUnderlying(id);
+}
+
+TEST(EntityIdSetTest, empty)
+{
+    auto set = std::make_unique<EntityIdSet>();
+    ASSERT_TRUE(set->empty());
+    ASSERT_EQ(set->size(), 0U);
+    ASSERT_TRUE(set->Front().IsNull());
+    ASSERT_TRUE(set->begin() == set->end());
+}
+
+TEST(EntityIdSetTest, insert_erase)
+{
+    auto set = std::make_unique<EntityIdSet>();
+    ASSERT_TRUE(set->Insert(MakeId(5)));
+    ASSERT_FALSE(set->Insert(MakeId(5)));
+    ASSERT_TRUE(set->Contains(MakeId(5)));
+    ASSERT_FALSE(set->Contains(MakeId(6)));
+    ASSERT_EQ(set->size(), 1U);
+
+    ASSERT_FALSE(set->Erase(MakeId(6)));
+    ASSERT_TRUE(set->Erase(MakeId(5)));
+    ASSERT_FALSE(set->Erase(MakeId(5)));
+    ASSERT_TRUE(set->empty());
+}
+
+TEST(EntityIdSetTest, iterates_in_id_order)
+{
+    auto set = std::make_unique<EntityIdSet>();
+    std::set<uint16_t> expected;
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<uint16_t> dist(0, 65534);
+    for (int32_t i = 0; i < 20000; i++)
+    {
+        const auto id = dist(rng);
+        if (i % 3 == 0)
+        {
+            ASSERT_EQ(set->Erase(MakeId(id)), expected.erase(id) != 0);
+        }
+        else
+        {
+            ASSERT_EQ(set->Insert(MakeId(id)), expected.insert(id).second);
+        }
+    }
+
+    // The boundaries of words and summary words.
+    for (uint16_t id : { 0, 63, 64, 4095, 4096, 65534 })
+    {
+        set->Insert(MakeId(id));
+        expected.insert(id);
+    }
+
+    std::vector<uint16_t> actual;
+    for (auto id : *set)
+    {
+        actual.push_back(id.ToUnderlying());
+    }
+    ASSERT_EQ(set->size(), expected.size());
+    ASSERT_TRUE(std::equal(actual.begin(), actual.end(), expected.begin(), expected.end()));
+    ASSERT_EQ(set->Front().ToUnderlying(), *expected.begin());
+}
+
+TEST(EntityIdSetTest, modify_while_iterating)
+{
+    auto set = std::make_unique<EntityIdSet>();
+    for (uint16_t id = 0; id < 1000; id += 10)
+    {
+        set->Insert(MakeId(id));
+    }
+
+    // Removing the current id and adding ids ahead of it, ids added behind it are not visited.
+    std::vector<uint16_t> visited;
+    for (auto id : *set)
+    {
+        visited.push_back(id.ToUnderlying());
+        set->Erase(id);
+        if (id.ToUnderlying() == 500)
+        {
+            set->Insert(MakeId(505));
+            set->Insert(MakeId(5));
+        }
+    }
+
+    ASSERT_EQ(visited.size(), 101U);
+    ASSERT_TRUE(std::is_sorted(visited.begin(), visited.end()));
+    ASSERT_NE(std::find(visited.begin(), visited.end(), 505), visited.end());
+    ASSERT_EQ(std::find(visited.begin(), visited.end(), 5), visited.end());
+    ASSERT_EQ(set->size(), 1U);
+    ASSERT_EQ(set->Front().ToUnderlying(), 5);
+}
+
+TEST(EntityIdSetTest, clear)
+{
+    auto set = std::make_unique<EntityIdSet>();
+    for (uint16_t id = 0; id < 65535; id++)
+    {
+        set->Insert(MakeId(id));
+    }
+    ASSERT_EQ(set->size(), 65535U);
+    ASSERT_EQ(set->Next(MakeId(65533)).ToUnderlying(), 65534);
+    ASSERT_TRUE(set->Next(MakeId(65534)).IsNull());
+
+    set->Clear();
+    ASSERT_TRUE(set->empty());
+    ASSERT_TRUE(set->Front().IsNull());
+}
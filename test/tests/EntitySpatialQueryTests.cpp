@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/entity/EntityList.h>
+#include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/Litter.h>
+#include <random>
+#include <vector>
+
+class EntitySpatialQueryTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ResetAllEntities();
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int32_t> dist(32, 32 * 40);
+        for (int32_t i = 0; i < 2000; i++)
+        {
+            auto* litter = CreateEntity<Litter>();
+            ASSERT_NE(litter, nullptr);
+            litter->MoveTo({ dist(rng), dist(rng), 0 });
+        }
+    }
+
+    void TearDown() override
+    {
+        ResetAllEntities();
+    }
+
+    static int32_t Distance(const CoordsXY& loc, const Litter& litter)
+    {
+        return std::abs(litter.x - loc.x) + std::abs(litter.y - loc.y);
+    }
+};
+
+TEST_F(EntitySpatialQueryTest, radius_matches_full_scan)
+{
+    const CoordsXY centre{ 32 * 20, 32 * 20 };
+    constexpr int32_t radius = 160;
+
+    std::vector<EntityId> expected;
+    for (auto* litter : EntityList<Litter>())
+    {
+        if (std::max(std::abs(litter->x - centre.x), std::abs(litter->y - centre.y)) <= radius)
+            expected.push_back(litter->Id);
+    }
+
+    std::vector<EntityId> actual;
+    ForEachEntityInRadius<Litter>(centre, radius, [&](const Litter& litter) {
+        if (std::max(std::abs(litter.x - centre.x), std::abs(litter.y - centre.y)) <= radius)
+            actual.push_back(litter.Id);
+    });
+    std::sort(actual.begin(), actual.end());
+
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(actual, expected);
+}
+
+TEST_F(EntitySpatialQueryTest, nearest_matches_full_scan)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int32_t> dist(0, 32 * 42);
+    for (int32_t i = 0; i < 100; i++)
+    {
+        const CoordsXY loc{ dist(rng), dist(rng) };
+        const auto distanceFn = [&loc](const Litter& litter) { return Distance(loc, litter); };
+
+        // The first entity in id order with the smallest distance, as the full scans used to pick.
+        Litter* expected = nullptr;
+        for (auto* litter : EntityList<Litter>())
+        {
+            if (expected == nullptr || Distance(loc, *litter) < Distance(loc, *expected))
+                expected = litter;
+        }
+
+        auto* actual = GetNearestEntity<Litter>(loc, 96, distanceFn);
+        if (Distance(loc, *expected) <= 96)
+        {
+            ASSERT_EQ(actual, expected);
+        }
+        else if (actual != nullptr)
+        {
+            ASSERT_GT(Distance(loc, *actual), 96);
+        }
+    }
+}
+
+TEST_F(EntitySpatialQueryTest, nearest_n_is_ordered)
+{
+    const CoordsXY loc{ 32 * 20, 32 * 20 };
+    const auto distanceFn = [&loc](const Litter& litter) { return Distance(loc, litter); };
+
+    auto nearest = GetNearestEntities<Litter>(loc, 256, 10, distanceFn);
+    ASSERT_EQ(nearest.size(), 10U);
+    ASSERT_EQ(nearest.front(), GetNearestEntity<Litter>(loc, 256, distanceFn));
+    for (size_t i = 1; i < nearest.size(); i++)
+    {
+        const auto prev = Distance(loc, *nearest[i - 1]);
+        const auto cur = Distance(loc, *nearest[i]);
+        ASSERT_TRUE(prev < cur || (prev == cur && nearest[i - 1]->Id.ToUnderlying() < nearest[i]->Id.ToUnderlying()));
+    }
+}
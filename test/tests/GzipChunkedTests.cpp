@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <cstring>
+#include <gtest/gtest.h>
+#include <openrct2/util/Util.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+static std::vector<uint8_t> CreateData(size_t length)
+{
+    // Runs of repeated bytes so the data compresses a bit, like a park does.
+    std::mt19937 rng(0x677a);
+    std::uniform_int_distribution<int32_t> dist(0, 255);
+    std::vector<uint8_t> data;
+    while (data.size() < length)
+    {
+        data.insert(data.end(), std::min<size_t>(1 + dist(rng) % 16, length - data.size()), static_cast<uint8_t>(dist(rng)));
+    }
+    return data;
+}
+
+TEST(GzipChunkedTest, roundtrip)
+{
+    for (size_t length : { 0, 1, 999, 1000, 1001, 25000 })
+    {
+        const auto data = CreateData(length);
+        const auto compressed = GzipChunked(data.data(), data.size(), GzipLevelDefault, 1000);
+        ASSERT_EQ(UngzipChunked(compressed.data(), compressed.size()), data) << length << " bytes";
+    }
+}
+
+TEST(GzipChunkedTest, default_block_size)
+{
+    const auto data = CreateData(3 * 1024 * 1024 + 17);
+    const auto compressed = GzipChunked(data.data(), data.size());
+    ASSERT_LT(compressed.size(), data.size());
+    ASSERT_EQ(UngzipChunked(compressed.data(), compressed.size()), data);
+}
+
+TEST(GzipChunkedTest, corrupt_data_throws)
+{
+    const auto data = CreateData(5000);
+    const auto compressed = GzipChunked(data.data(), data.size(), GzipLevelDefault, 1000);
+
+    // Too short for the header.
+    EXPECT_THROW(UngzipChunked(compressed.data(), 8), std::runtime_error);
+
+    // Missing the end of the last member.
+    EXPECT_THROW(UngzipChunked(compressed.data(), compressed.size() - 1), std::runtime_error);
+
+    // Wrong uncompressed size.
+    auto corrupt = compressed;
+    corrupt[0]++;
+    EXPECT_THROW(UngzipChunked(corrupt.data(), corrupt.size()), std::runtime_error);
+
+    // Damaged member.
+    corrupt = compressed;
+    corrupt[corrupt.size() - 100] ^= 0xFF;
+    EXPECT_THROW(UngzipChunked(corrupt.data(), corrupt.size()), std::runtime_error);
+}
+
+TEST(GzipChunkedTest, uncompressed_size_is_limited)
+{
+    const auto data = CreateData(5000);
+    const auto compressed = GzipChunked(data.data(), data.size(), GzipLevelDefault, 64 * 1024 * 1024);
+    ASSERT_EQ(UngzipChunked(compressed.data(), compressed.size(), data.size()), data);
+
+    // More than the caller expects.
+    EXPECT_THROW(UngzipChunked(compressed.data(), compressed.size(), data.size() - 1), std::runtime_error);
+
+    // A small input claiming to hold far more than deflate can compress into it.
+    auto corrupt = compressed;
+    const uint64_t uncompressedSize = 60 * 1024 * 1024;
+    std::memcpy(corrupt.data(), &uncompressedSize, sizeof(uncompressedSize));
+    EXPECT_THROW(UngzipChunked(corrupt.data(), corrupt.size()), std::runtime_error);
+}
+
+TEST(GzipChunkedTest, fast_level)
+{
+    const auto data = CreateData(25000);
+    const auto compressed = GzipChunked(data.data(), data.size(), GzipLevelFast, 1000);
+    ASSERT_EQ(UngzipChunked(compressed.data(), compressed.size()), data);
+
+    const auto gzipped = Gzip(data.data(), data.size(), GzipLevelFast);
+    ASSERT_EQ(Ungzip(gzipped.data(), gzipped.size()), data);
+}
+
+TEST(ZstdChunkedTest, roundtrip)
+{
+    for (size_t length : { 0, 1, 999, 1000, 1001, 25000 })
+    {
+        const auto data = CreateData(length);
+        for (auto level : { ZstdLevelDefault, ZstdLevelFast })
+        {
+            const auto compressed = ZstdChunked(data.data(), data.size(), level, 1000);
+            ASSERT_EQ(UnzstdChunked(compressed.data(), compressed.size()), data) << length << " bytes";
+        }
+    }
+}
+
+TEST(ZstdChunkedTest, corrupt_data_throws)
+{
+    const auto data = CreateData(5000);
+    const auto compressed = ZstdChunked(data.data(), data.size(), ZstdLevelDefault, 1000);
+
+    // Missing the end of the last member.
+    EXPECT_THROW(UnzstdChunked(compressed.data(), compressed.size() - 1), std::runtime_error);
+
+    // Damaged member.
+    auto corrupt = compressed;
+    corrupt[corrupt.size() - 10] ^= 0xFF;
+    EXPECT_THROW(UnzstdChunked(corrupt.data(), corrupt.size()), std::runtime_error);
+
+    // Members of the other codec.
+    const auto gzipped = GzipChunked(data.data(), data.size(), GzipLevelDefault, 1000);
+    EXPECT_THROW(UnzstdChunked(gzipped.data(), gzipped.size()), std::runtime_error);
+    EXPECT_THROW(UngzipChunked(compressed.data(), compressed.size()), std::runtime_error);
+
+    // More than the caller expects.
+    EXPECT_THROW(UnzstdChunked(compressed.data(), compressed.size(), data.size() - 1), std::runtime_error);
+}
@@ -0,0 +1,59 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <openrct2/core/FileSystem.hpp>
+#include <openrct2/core/Imaging.h>
+#include <vector>
+
+TEST(ImagingTest, png_writer_writes_rows_in_strips)
+{
+    constexpr uint32_t width = 37;
+    constexpr uint32_t height = 50;
+
+    GamePalette palette;
+    for (uint16_t i = 0; i < PALETTE_SIZE; i++)
+    {
+        palette[i] = { static_cast<uint8_t>(i), static_cast<uint8_t>(255 - i), static_cast<uint8_t>(i / 2), 255 };
+    }
+
+    // Rows with some padding at the end, as the strips of a screenshot have.
+    constexpr uint32_t stride = width + 3;
+    std::vector<uint8_t> pixels(stride * height);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            pixels[y * stride + x] = static_cast<uint8_t>(x * 7 + y * 13);
+        }
+    }
+
+    const auto path = (fs::temp_directory_path() / "openrct2_png_writer_test.png").u8string();
+    {
+        Imaging::PngWriter writer(path, width, height, palette);
+        writer.WriteRows(pixels.data(), 16, stride);
+        writer.WriteRows(pixels.data() + 16 * stride, 33, stride);
+        ASSERT_THROW(writer.Finish(), std::runtime_error);
+        ASSERT_THROW(writer.WriteRows(pixels.data(), 2, stride), std::out_of_range);
+        writer.WriteRows(pixels.data() + 49 * stride, 1, stride);
+        writer.Finish();
+    }
+
+    const auto image = Imaging::ReadFromFile(path, IMAGE_FORMAT::PNG);
+    fs::remove(fs::u8path(path));
+
+    ASSERT_EQ(image.Width, width);
+    ASSERT_EQ(image.Height, height);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            ASSERT_EQ(image.Pixels[y * width + x], pixels[y * stride + x]);
+        }
+    }
+}
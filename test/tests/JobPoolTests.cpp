@@ -0,0 +1,172 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <atomic>
+#include <gtest/gtest.h>
+#include <openrct2/core/JobPool.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(JobPoolTest, parallel_for_visits_every_index_once)
+{
+    JobPool pool(4);
+
+    for (size_t grainSize : { 1, 7, 64, 5000 })
+    {
+        std::vector<std::atomic<uint32_t>> visits(4096);
+        pool.ParallelFor(
+            visits.size(), [&](size_t i) { visits[i].fetch_add(1, std::memory_order_relaxed); }, grainSize);
+
+        for (const auto& count : visits)
+        {
+            ASSERT_EQ(count.load(), 1U);
+        }
+    }
+}
+
+TEST(JobPoolTest, parallel_for_empty_range)
+{
+    JobPool pool(2);
+    bool called = false;
+    pool.ParallelFor(0, [&](size_t) { called = true; });
+    ASSERT_FALSE(called);
+}
+
+TEST(JobPoolTest, task_group_waits_for_all_tasks)
+{
+    JobPool pool(4);
+    JobPool::TaskGroup group(pool);
+
+    // More tasks than fit into the inline storage and a single deque.
+    constexpr size_t numTasks = 3000;
+    std::atomic<size_t> completed = 0;
+    for (size_t i = 0; i < numTasks; i++)
+    {
+        group.Run([&completed]() { completed++; });
+    }
+    group.Wait();
+    ASSERT_EQ(completed.load(), numTasks);
+
+    // The group can be reused after waiting.
+    for (size_t i = 0; i < numTasks; i++)
+    {
+        group.Run([&completed]() { completed++; });
+    }
+    group.Wait();
+    ASSERT_EQ(completed.load(), numTasks * 2);
+}
+
+TEST(JobPoolTest, nested_parallelism)
+{
+    JobPool pool(4);
+
+    std::atomic<size_t> total = 0;
+    pool.ParallelFor(16, [&](size_t) {
+        JobPool::TaskGroup inner(pool);
+        for (size_t i = 0; i < 64; i++)
+        {
+            inner.Run([&total]() { total++; });
+        }
+        inner.Wait();
+        pool.ParallelFor(32, [&](size_t) { total++; });
+    });
+    ASSERT_EQ(total.load(), 16U * (64 + 32));
+}
+
+TEST(JobPoolTest, task_exception_is_rethrown_from_wait)
+{
+    JobPool pool(4);
+    JobPool::TaskGroup group(pool);
+
+    std::atomic<size_t> completed = 0;
+    for (size_t i = 0; i < 100; i++)
+    {
+        group.Run([&completed, i]() {
+            if (i == 50)
+                throw std::runtime_error("task failed");
+            completed++;
+        });
+    }
+    ASSERT_THROW(group.Wait(), std::runtime_error);
+    ASSERT_EQ(completed.load(), 99U);
+
+    // The exception is only reported once and the group stays usable.
+    group.Run([&completed]() { completed++; });
+    group.Wait();
+    ASSERT_EQ(completed.load(), 100U);
+}
+
+TEST(JobPoolTest, parallel_for_exception_is_rethrown)
+{
+    JobPool pool(4);
+    ASSERT_THROW(
+        pool.ParallelFor(
+            1000,
+            [](size_t i) {
+                if (i == 999)
+                    throw std::runtime_error("item failed");
+            }),
+        std::runtime_error);
+}
+
+TEST(JobPoolTest, wait_on_long_task)
+{
+    JobPool pool(2);
+    JobPool::TaskGroup group(pool);
+
+    // Long enough for the waiting thread to stop spinning and sleep.
+    std::atomic_bool done = false;
+    group.Run([&done]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        done = true;
+    });
+    group.Wait();
+    ASSERT_TRUE(done.load());
+}
+
+TEST(JobPoolTest, background_job_runs_while_group_waits)
+{
+    JobPool pool(2);
+
+    std::atomic_bool release = false;
+    std::atomic_bool done = false;
+    pool.RunInBackground([&]() {
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    // The waiting thread must not pick up the background job, or it would never return.
+    JobPool::TaskGroup group(pool);
+    std::atomic<size_t> count = 0;
+    for (size_t n = 0; n < 64; n++)
+    {
+        group.Run([&count]() { count++; });
+    }
+    group.Wait();
+    ASSERT_EQ(count.load(), 64U);
+
+    release = true;
+    while (!done)
+    {
+        std::this_thread::yield();
+    }
+}
+
+TEST(JobPoolTest, shared_pool)
+{
+    auto& pool = JobPool::GetShared();
+    ASSERT_EQ(&pool, &JobPool::GetShared());
+
+    std::atomic<size_t> sum = 0;
+    pool.ParallelFor(1000, [&](size_t i) { sum += i; });
+    ASSERT_EQ(sum.load(), 1000U * 999 / 2);
+}
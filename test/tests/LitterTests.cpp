@@ -0,0 +1,187 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <openrct2/Game.h>
+#include <openrct2/entity/EntityList.h>
+#include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/Litter.h>
+#include <random>
+#include <vector>
+
+class LitterAgedCountTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        gCurrentTicks = 100000;
+        ResetAllEntities();
+    }
+
+    void TearDown() override
+    {
+        ResetAllEntities();
+        gCurrentTicks = 0;
+    }
+
+    static Litter* CreateLitter()
+    {
+        auto* litter = CreateEntity<Litter>();
+        if (litter != nullptr)
+        {
+            litter->creationTick = gCurrentTicks;
+        }
+        return litter;
+    }
+
+    static uint32_t CountAgedLitter()
+    {
+        uint32_t count = 0;
+        for (auto* litter : EntityList<Litter>())
+        {
+            if (litter->GetAge() >= Litter::AgedTicks)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+TEST_F(LitterAgedCountTest, litter_ages_at_threshold)
+{
+    ASSERT_NE(CreateLitter(), nullptr);
+    ASSERT_EQ(Litter::GetAgedCount(), 0U);
+
+    gCurrentTicks += Litter::AgedTicks - 1;
+    ASSERT_EQ(Litter::GetAgedCount(), 0U);
+
+    gCurrentTicks++;
+    ASSERT_EQ(Litter::GetAgedCount(), 1U);
+
+    gCurrentTicks += 100000;
+    ASSERT_EQ(Litter::GetAgedCount(), 1U);
+}
+
+TEST_F(LitterAgedCountTest, remove_before_and_after_threshold)
+{
+    auto* young = CreateLitter();
+    auto* old = CreateLitter();
+    ASSERT_NE(young, nullptr);
+    ASSERT_NE(old, nullptr);
+    ASSERT_EQ(Litter::GetAgedCount(), 0U);
+
+    // Removing young litter must not make the remaining young litter count as aged later on.
+    gCurrentTicks += Litter::AgedTicks / 2;
+    EntityRemove(young);
+    ASSERT_EQ(Litter::GetAgedCount(), 0U);
+
+    gCurrentTicks += Litter::AgedTicks;
+    ASSERT_EQ(Litter::GetAgedCount(), 1U);
+
+    EntityRemove(old);
+    ASSERT_EQ(Litter::GetAgedCount(), 0U);
+}
+
+TEST_F(LitterAgedCountTest, remove_in_creation_tick)
+{
+    ASSERT_EQ(Litter::GetAgedCount(), 0U);
+
+    // Removed before the count was queried again.
+    auto* litter = CreateLitter();
+    ASSERT_NE(litter, nullptr);
+    EntityRemove(litter);
+    ASSERT_EQ(Litter::GetAgedCount(), 0U);
+
+    // Removed after the count was queried in the same tick.
+    litter = CreateLitter();
+    ASSERT_NE(litter, nullptr);
+    ASSERT_EQ(Litter::GetAgedCount(), 0U);
+    EntityRemove(litter);
+    ASSERT_EQ(Litter::GetAgedCount(), 0U);
+
+    ASSERT_NE(CreateLitter(), nullptr);
+    gCurrentTicks += Litter::AgedTicks;
+    ASSERT_EQ(Litter::GetAgedCount(), 1U);
+}
+
+TEST_F(LitterAgedCountTest, backwards_tick_jump)
+{
+    ASSERT_NE(CreateLitter(), nullptr);
+    gCurrentTicks += Litter::AgedTicks;
+    ASSERT_NE(CreateLitter(), nullptr);
+    ASSERT_EQ(Litter::GetAgedCount(), 1U);
+
+    // Such as loading a park that was saved earlier, the litter is younger again.
+    gCurrentTicks -= Litter::AgedTicks / 2;
+    ASSERT_EQ(Litter::GetAgedCount(), CountAgedLitter());
+
+    gCurrentTicks = 10;
+    ASSERT_EQ(Litter::GetAgedCount(), CountAgedLitter());
+
+    gCurrentTicks += 2 * Litter::AgedTicks;
+    ASSERT_EQ(Litter::GetAgedCount(), CountAgedLitter());
+}
+
+TEST_F(LitterAgedCountTest, reset_clears_count)
+{
+    ASSERT_NE(CreateLitter(), nullptr);
+    gCurrentTicks += Litter::AgedTicks;
+    ASSERT_EQ(Litter::GetAgedCount(), 1U);
+
+    ResetAllEntities();
+    ASSERT_EQ(Litter::GetAgedCount(), 0U);
+
+    // Litter that is loaded with an old creation tick counts as aged straight away.
+    auto* litter = CreateLitter();
+    ASSERT_NE(litter, nullptr);
+    litter->creationTick = gCurrentTicks - Litter::AgedTicks;
+    ASSERT_NE(CreateLitter(), nullptr);
+    ASSERT_EQ(Litter::GetAgedCount(), 1U);
+}
+
+TEST_F(LitterAgedCountTest, matches_brute_force_count)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> action(0, 99);
+    std::uniform_int_distribution<uint32_t> ticks(1, Litter::AgedTicks / 4);
+
+    std::vector<Litter*> litter;
+    for (int32_t step = 0; step < 5000; step++)
+    {
+        const auto roll = action(rng);
+        if (roll < 45)
+        {
+            auto* created = CreateLitter();
+            if (created != nullptr)
+            {
+                litter.push_back(created);
+            }
+        }
+        else if (roll < 75 && !litter.empty())
+        {
+            const auto index = std::uniform_int_distribution<size_t>(0, litter.size() - 1)(rng);
+            EntityRemove(litter[index]);
+            litter.erase(litter.begin() + index);
+        }
+        else if (roll < 98)
+        {
+            gCurrentTicks += ticks(rng);
+        }
+        else
+        {
+            gCurrentTicks -= ticks(rng);
+        }
+
+        // Not every tick queries the count, like the park rating which is only updated every few ticks.
+        if (step % 3 == 0)
+        {
+            ASSERT_EQ(Litter::GetAgedCount(), CountAgedLitter()) << "step " << step;
+        }
+    }
+}
@@ -0,0 +1,120 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <openrct2/network/NetworkMapDelta.h>
+#include <openrct2/util/Util.h>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+static std::vector<uint8_t> CreateMap(size_t length, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int32_t> dist(0, 255);
+    std::vector<uint8_t> data(length);
+    for (auto& b : data)
+    {
+        b = static_cast<uint8_t>(dist(rng));
+    }
+    return data;
+}
+
+static std::vector<NetworkMapBlockHash> GetHashes(const std::vector<NetworkMapBlock>& blocks)
+{
+    std::vector<NetworkMapBlockHash> hashes;
+    for (const auto& block : blocks)
+    {
+        hashes.push_back(block.Hash);
+    }
+    return hashes;
+}
+
+TEST(NetworkMapDeltaTest, split_covers_data)
+{
+    for (size_t length : { 0, 1, 4096, 1024 * 1024 + 7 })
+    {
+        const auto data = CreateMap(length, 0x6d6170);
+        const auto blocks = NetworkMapSplitBlocks(data.data(), data.size());
+        size_t offset = 0;
+        for (const auto& block : blocks)
+        {
+            ASSERT_EQ(block.Offset, offset);
+            ASSERT_GT(block.Length, 0U);
+            ASSERT_LE(block.Length, 64U * 1024U);
+            offset += block.Length;
+        }
+        ASSERT_EQ(offset, length);
+    }
+}
+
+TEST(NetworkMapDeltaTest, roundtrip_without_base)
+{
+    const auto map = CreateMap(300000, 0x6d6170);
+    const auto delta = NetworkMapEncodeDelta(map.data(), map.size(), {}, ZstdLevelFast);
+    ASSERT_EQ(NetworkMapDecodeDelta(delta.data(), delta.size(), {}, {}), map);
+}
+
+TEST(NetworkMapDeltaTest, only_changes_are_sent)
+{
+    const auto base = CreateMap(2 * 1024 * 1024, 0x6d6170);
+    const auto baseBlocks = NetworkMapSplitBlocks(base.data(), base.size());
+
+    // Bytes inserted near the start shift everything after them.
+    auto map = base;
+    const auto inserted = CreateMap(100, 0x696e73);
+    map.insert(map.begin() + 1000, inserted.begin(), inserted.end());
+    map[map.size() / 2] ^= 0xFF;
+    map.resize(map.size() - 5000);
+
+    const auto fullDelta = NetworkMapEncodeDelta(map.data(), map.size(), {}, ZstdLevelFast);
+    const auto delta = NetworkMapEncodeDelta(map.data(), map.size(), GetHashes(baseBlocks), ZstdLevelFast);
+    ASSERT_LT(delta.size() * 10, fullDelta.size());
+    ASSERT_EQ(NetworkMapDecodeDelta(delta.data(), delta.size(), base, baseBlocks), map);
+}
+
+TEST(NetworkMapDeltaTest, wrong_base_throws)
+{
+    const auto base = CreateMap(200000, 0x6d6170);
+    const auto baseBlocks = NetworkMapSplitBlocks(base.data(), base.size());
+    const auto delta = NetworkMapEncodeDelta(base.data(), base.size(), GetHashes(baseBlocks), ZstdLevelFast);
+
+    // The client's copy of the map changed after it sent the hashes.
+    auto changedBase = base;
+    changedBase[100] ^= 0xFF;
+    EXPECT_THROW(NetworkMapDecodeDelta(delta.data(), delta.size(), changedBase, baseBlocks), std::runtime_error);
+
+    // Blocks that are not there.
+    EXPECT_THROW(NetworkMapDecodeDelta(delta.data(), delta.size(), {}, {}), std::runtime_error);
+}
+
+TEST(NetworkMapDeltaTest, truncated_literal_throws)
+{
+    const auto map = CreateMap(200000, 0x6d6170);
+    const auto delta = NetworkMapEncodeDelta(map.data(), map.size(), {}, ZstdLevelFast);
+
+    // The literal claims more data than the delta holds.
+    auto decompressed = UnzstdChunked(delta.data(), delta.size());
+    decompressed.resize(decompressed.size() - 1000);
+    const auto truncated = ZstdChunked(decompressed.data(), decompressed.size(), ZstdLevelFast);
+    EXPECT_THROW(NetworkMapDecodeDelta(truncated.data(), truncated.size(), {}, {}), std::runtime_error);
+}
+
+TEST(NetworkMapDeltaTest, oversized_map_throws)
+{
+    const auto map = CreateMap(4096, 0x6d6170);
+    const auto delta = NetworkMapEncodeDelta(map.data(), map.size(), {}, ZstdLevelFast);
+
+    // The map size is the first field of the header.
+    auto decompressed = UnzstdChunked(delta.data(), delta.size());
+    const uint64_t mapSize = UINT64_MAX;
+    std::memcpy(decompressed.data(), &mapSize, sizeof(mapSize));
+    const auto oversized = ZstdChunked(decompressed.data(), decompressed.size(), ZstdLevelFast);
+    EXPECT_THROW(NetworkMapDecodeDelta(oversized.data(), oversized.size(), {}, {}), std::runtime_error);
+}
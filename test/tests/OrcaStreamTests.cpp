@@ -0,0 +1,125 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/core/OrcaStream.hpp>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class OrcaStreamTest : public testing::Test
+{
+protected:
+    // A chunk spanning several blocks between two small ones.
+    std::vector<std::vector<uint8_t>> _chunks;
+
+    void SetUp() override
+    {
+        std::mt19937 rng(0x4f524341);
+        std::uniform_int_distribution<int32_t> dist(0, 15);
+        for (size_t length : { 100, 700 * 1024, 0, 3000 })
+        {
+            auto& chunk = _chunks.emplace_back(length);
+            for (auto& b : chunk)
+            {
+                b = static_cast<uint8_t>(dist(rng));
+            }
+        }
+    }
+
+    MemoryStream Write(uint32_t compression)
+    {
+        MemoryStream ms;
+        {
+            OrcaStream os(ms, OrcaStream::Mode::WRITING);
+            os.GetHeader().Compression = compression;
+            for (uint32_t i = 0; i < _chunks.size(); i++)
+            {
+                os.ReadWriteChunk(i + 1, [&](OrcaStream::ChunkStream& cs) {
+                    if (!_chunks[i].empty())
+                        cs.Write(_chunks[i].data(), _chunks[i].size());
+                });
+            }
+        }
+        ms.SetPosition(0);
+        return ms;
+    }
+
+    void CheckChunk(OrcaStream& os, uint32_t index)
+    {
+        std::vector<uint8_t> data(_chunks[index].size());
+        ASSERT_TRUE(os.ReadWriteChunk(index + 1, [&](OrcaStream::ChunkStream& cs) {
+            if (!data.empty())
+                cs.Read(data.data(), data.size());
+        }));
+        ASSERT_EQ(data, _chunks[index]) << "chunk " << index;
+    }
+
+    void CheckReadsInAnyOrder(uint32_t compression)
+    {
+        auto ms = Write(compression);
+        OrcaStream os(ms, OrcaStream::Mode::READING);
+        ASSERT_EQ(os.GetHeader().Compression, compression);
+        for (uint32_t index : { 3, 0, 1, 2, 1 })
+        {
+            CheckChunk(os, index);
+        }
+        ASSERT_FALSE(os.ReadWriteChunk(99, [](OrcaStream::ChunkStream&) {}));
+    }
+};
+
+TEST_F(OrcaStreamTest, chunked_reads_in_any_order)
+{
+    CheckReadsInAnyOrder(OrcaStream::COMPRESSION_GZIP_CHUNKED);
+}
+
+TEST_F(OrcaStreamTest, gzip_reads_in_any_order)
+{
+    CheckReadsInAnyOrder(OrcaStream::COMPRESSION_GZIP);
+}
+
+TEST_F(OrcaStreamTest, uncompressed_reads_in_any_order)
+{
+    CheckReadsInAnyOrder(OrcaStream::COMPRESSION_NONE);
+}
+
+TEST_F(OrcaStreamTest, chunked_reads_only_needed_blocks)
+{
+    auto ms = Write(OrcaStream::COMPRESSION_GZIP_CHUNKED);
+    std::vector<uint8_t> data(
+        static_cast<const uint8_t*>(ms.GetData()), static_cast<const uint8_t*>(ms.GetData()) + ms.GetLength());
+
+    // The data is 3 blocks, the small chunks lie in the first and the last. Damage the middle block, which only the
+    // large chunk needs, behind the header, the chunk table, the chunked data header and its table of member sizes.
+    constexpr size_t membersTableStart = 64 + 4 * 20 + 16;
+    uint32_t firstMemberSize;
+    std::memcpy(&firstMemberSize, data.data() + membersTableStart, sizeof(firstMemberSize));
+    data[membersTableStart + 3 * sizeof(uint32_t) + firstMemberSize + 20] ^= 0xFF;
+
+    MemoryStream corrupt(data.data(), data.size());
+    OrcaStream os(corrupt, OrcaStream::Mode::READING);
+    CheckChunk(os, 0);
+    CheckChunk(os, 3);
+    EXPECT_THROW(os.ReadWriteChunk(2, [](OrcaStream::ChunkStream&) {}), std::runtime_error);
+}
+
+TEST_F(OrcaStreamTest, gzip_reads_only_needed_data)
+{
+    auto ms = Write(OrcaStream::COMPRESSION_GZIP);
+
+    // Cut the compressed data in half, the first chunk lies at its start and the last chunk behind the large one.
+    const auto halfLength = static_cast<size_t>(ms.GetLength()) / 2;
+    MemoryStream truncated(ms.GetData(), halfLength);
+    OrcaStream os(truncated, OrcaStream::Mode::READING);
+    CheckChunk(os, 0);
+    EXPECT_THROW(os.ReadWriteChunk(4, [](OrcaStream::ChunkStream&) {}), std::runtime_error);
+}
@@ -0,0 +1,80 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <openrct2/paint/Paint.h>
+
+TEST(PaintEntryPoolTest, stats_track_nodes)
+{
+    PaintEntryPool pool;
+    {
+        auto chain = pool.Create();
+        for (size_t i = 0; i < PaintEntryPool::NodeSize * 2 + 1; i++)
+        {
+            ASSERT_NE(chain.Allocate(), nullptr);
+        }
+
+        auto stats = pool.GetStats();
+        ASSERT_EQ(stats.NodesInUse, 3U);
+        ASSERT_EQ(stats.NodesTotal, 3U);
+        ASSERT_EQ(stats.NodesAllocated, 3U);
+        ASSERT_EQ(stats.HighWaterMark, 3U);
+    }
+
+    auto stats = pool.GetStats();
+    ASSERT_EQ(stats.NodesInUse, 0U);
+    ASSERT_EQ(stats.NodesTotal, 3U);
+    ASSERT_EQ(stats.HighWaterMark, 3U);
+
+    pool.ResetFrameStats();
+    stats = pool.GetStats();
+    ASSERT_EQ(stats.NodesAllocated, 0U);
+    ASSERT_EQ(stats.HighWaterMark, 0U);
+}
+
+TEST(PaintEntryPoolTest, reserved_nodes_are_reused)
+{
+    PaintEntryPool pool;
+    pool.Reserve(4);
+    ASSERT_EQ(pool.GetStats().NodesTotal, 4U);
+
+    {
+        auto chain = pool.Create();
+        for (size_t i = 0; i < PaintEntryPool::NodeSize * 4; i++)
+        {
+            ASSERT_NE(chain.Allocate(), nullptr);
+        }
+        ASSERT_EQ(pool.GetStats().NodesAllocated, 0U);
+    }
+
+    pool.Trim(1);
+    ASSERT_EQ(pool.GetStats().NodesTotal, 1U);
+}
+
+TEST(PaintEntryPoolTest, splice_moves_nodes)
+{
+    PaintEntryPool pool;
+    auto chain = pool.Create();
+    auto other = pool.Create();
+    for (size_t i = 0; i < PaintEntryPool::NodeSize + 1; i++)
+    {
+        ASSERT_NE(other.Allocate(), nullptr);
+    }
+
+    chain.Splice(other);
+    ASSERT_EQ(chain.GetCount(), PaintEntryPool::NodeSize + 1);
+    ASSERT_EQ(other.GetCount(), 0U);
+
+    ASSERT_NE(chain.Allocate(), nullptr);
+    ASSERT_EQ(chain.GetCount(), PaintEntryPool::NodeSize + 2);
+    ASSERT_EQ(pool.GetStats().NodesInUse, 2U);
+
+    chain.Clear();
+    other.Clear();
+    ASSERT_EQ(pool.GetStats().NodesInUse, 0U);
+}
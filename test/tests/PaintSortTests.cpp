@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <openrct2/paint/Paint.h>
+#include <openrct2/sprites.h>
+
+class PaintSortTest : public testing::Test
+{
+protected:
+    G1Element _g1{};
+
+    void SetUp() override
+    {
+        _g1.width = 32;
+        _g1.height = 32;
+        _g1.x_offset = -16;
+        _g1.y_offset = -16;
+        GfxSetG1Element(SPR_TEMP, &_g1);
+    }
+};
+
+TEST_F(PaintSortTest, merged_parts_match_serial_generation)
+{
+    PaintEntryPool pool;
+    const auto createSession = [&pool]() {
+        auto session = std::make_unique<PaintSession>();
+        session->DPI.x = -4096;
+        session->DPI.y = -4096;
+        session->DPI.width = 8192;
+        session->DPI.height = 8192;
+        session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
+        session->PaintEntryChain = pool.Create();
+        return session;
+    };
+    const auto paintRows = [](PaintSession& session, int32_t firstRow, int32_t endRow) {
+        for (auto row = firstRow; row < endRow; row++)
+        {
+            for (int32_t i = 0; i < 4; i++)
+            {
+                session.SpritePosition = { row * 32 + i * 8, row * 32 };
+                const CoordsXYZ offset{ 0, 0, i * 8 };
+                PaintAddImageAsParent(session, ImageId(SPR_TEMP), offset, { offset, { 16, 16, 8 } });
+            }
+        }
+    };
+
+    auto serial = createSession();
+    paintRows(*serial, 0, 8);
+
+    auto first = createSession();
+    auto second = createSession();
+    auto third = createSession();
+    paintRows(*first, 0, 3);
+    paintRows(*second, 3, 6);
+    paintRows(*third, 6, 8);
+    PaintSessionMerge(*first, *second);
+    PaintSessionMerge(*first, *third);
+
+    ASSERT_EQ(first->PaintEntryChain.GetCount(), serial->PaintEntryChain.GetCount());
+    ASSERT_EQ(second->PaintEntryChain.GetCount(), 0U);
+    ASSERT_EQ(first->QuadrantBackIndex, serial->QuadrantBackIndex);
+    ASSERT_EQ(first->QuadrantFrontIndex, serial->QuadrantFrontIndex);
+    for (auto i = serial->QuadrantBackIndex; i <= serial->QuadrantFrontIndex; i++)
+    {
+        const auto* expected = serial->Quadrants[i];
+        const auto* actual = first->Quadrants[i];
+        for (; expected != nullptr && actual != nullptr; expected = expected->NextQuadrantEntry)
+        {
+            ASSERT_EQ(actual->ScreenPos, expected->ScreenPos);
+            ASSERT_EQ(actual->Bounds.z, expected->Bounds.z);
+            actual = actual->NextQuadrantEntry;
+        }
+        ASSERT_EQ(actual, nullptr);
+        ASSERT_EQ(expected, nullptr);
+    }
+}
@@ -0,0 +1,102 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <array>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/util/Util.h>
+#include <random>
+#include <vector>
+
+class RLERunTest : public testing::Test
+{
+protected:
+    std::mt19937 _rng{ 0x524c45 };
+    std::array<uint8_t, 256> _table{};
+    std::vector<uint8_t> _src;
+    std::vector<uint8_t> _dst;
+
+    void SetUp() override
+    {
+        // Every eighth entry maps to 0 so the kernels have to keep the destination for those.
+        std::uniform_int_distribution<int32_t> byteDist(1, 255);
+        for (size_t i = 0; i < _table.size(); i++)
+        {
+            _table[i] = (i % 8) == 3 ? 0 : static_cast<uint8_t>(byteDist(_rng));
+        }
+    }
+
+    void Randomise(int32_t numPixels)
+    {
+        std::uniform_int_distribution<int32_t> byteDist(0, 255);
+        _src.resize(numPixels);
+        _dst.resize(numPixels);
+        for (int32_t i = 0; i < numPixels; i++)
+        {
+            // Plenty of transparent source pixels.
+            _src[i] = (byteDist(_rng) % 4) == 0 ? 0 : static_cast<uint8_t>(byteDist(_rng));
+            _dst[i] = static_cast<uint8_t>(byteDist(_rng));
+        }
+    }
+
+    void CheckMatchesScalar(RLERunFunc scalarFunc, RLERunFunc simdFunc)
+    {
+        for (int32_t numPixels = 0; numPixels <= 100; numPixels++)
+        {
+            Randomise(numPixels);
+            auto expected = _dst;
+            scalarFunc(_src.data(), expected.data(), _table.data(), numPixels);
+            auto actual = _dst;
+            simdFunc(_src.data(), actual.data(), _table.data(), numPixels);
+            ASSERT_EQ(actual, expected) << "run of " << numPixels << " pixels";
+        }
+    }
+};
+
+TEST_F(RLERunTest, scalar_matches_blit_pixel)
+{
+    PaletteMap paletteMap(_table.data(), 1, 256);
+    Randomise(64);
+
+    auto expected = _dst;
+    for (size_t i = 0; i < _src.size(); i++)
+    {
+        BlitPixel<BLEND_TRANSPARENT | BLEND_SRC>(&_src[i], &expected[i], paletteMap);
+    }
+    auto actual = _dst;
+    RLERemapSrcRunScalar(_src.data(), actual.data(), paletteMap.GetLookupTable(), 64);
+    ASSERT_EQ(actual, expected);
+
+    expected = _dst;
+    for (size_t i = 0; i < _src.size(); i++)
+    {
+        BlitPixel<BLEND_TRANSPARENT | BLEND_DST>(&_src[i], &expected[i], paletteMap);
+    }
+    actual = _dst;
+    RLERemapDstRunScalar(_src.data(), actual.data(), paletteMap.GetLookupTable(), 64);
+    ASSERT_EQ(actual, expected);
+}
+
+TEST_F(RLERunTest, sse4_1_matches_scalar)
+{
+    // Nothing to compare against on CPUs without SSE 4.1.
+    if (!SSE41Available())
+        return;
+
+    CheckMatchesScalar(RLERemapSrcRunScalar, RLERemapSrcRunSse4_1);
+    CheckMatchesScalar(RLERemapDstRunScalar, RLERemapDstRunSse4_1);
+}
+
+TEST_F(RLERunTest, avx2_matches_scalar)
+{
+    if (!AVX2Available())
+        return;
+
+    CheckMatchesScalar(RLERemapSrcRunScalar, RLERemapSrcRunAvx2);
+    CheckMatchesScalar(RLERemapDstRunScalar, RLERemapDstRunAvx2);
+}
@@ -0,0 +1,204 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/drawing/SpriteCache.h>
+#include <random>
+#include <vector>
+
+class SpriteCacheTest : public testing::Test
+{
+protected:
+    static constexpr int32_t SpriteWidth = 90;
+    static constexpr int32_t SpriteHeight = 70;
+
+    std::vector<uint8_t> _spriteData;
+    G1Element _sprite{};
+    int32_t _savedCacheSize{};
+
+    void SetUp() override
+    {
+        _savedCacheSize = gConfigGeneral.SpriteCacheSize;
+        SpriteCacheInvalidate();
+        CreateSprite();
+    }
+
+    void TearDown() override
+    {
+        gConfigGeneral.SpriteCacheSize = _savedCacheSize;
+        SpriteCacheInvalidate();
+    }
+
+    // Encodes random lines with gaps and transparent pixels inside the runs, as RCT2 RLE.
+    void CreateSprite()
+    {
+        std::mt19937 rng(0x5350);
+        std::uniform_int_distribution<int32_t> dist(0, 255);
+
+        _spriteData.resize(SpriteHeight * 2);
+        for (int32_t y = 0; y < SpriteHeight; y++)
+        {
+            const auto lineOffset = _spriteData.size();
+            _spriteData[y * 2] = static_cast<uint8_t>(lineOffset & 0xFF);
+            _spriteData[y * 2 + 1] = static_cast<uint8_t>(lineOffset >> 8);
+
+            int32_t x = dist(rng) % 8;
+            size_t lastRunHeader = 0;
+            bool hasRuns = false;
+            while (x < SpriteWidth)
+            {
+                const auto length = std::min(1 + dist(rng) % 20, SpriteWidth - x);
+                lastRunHeader = _spriteData.size();
+                hasRuns = true;
+                _spriteData.push_back(static_cast<uint8_t>(length));
+                _spriteData.push_back(static_cast<uint8_t>(x));
+                for (int32_t i = 0; i < length; i++)
+                {
+                    _spriteData.push_back((dist(rng) % 6) == 0 ? 0 : static_cast<uint8_t>(dist(rng)));
+                }
+                x += length + dist(rng) % 6;
+            }
+            if (hasRuns)
+            {
+                _spriteData[lastRunHeader] |= 0x80;
+            }
+            else
+            {
+                _spriteData.push_back(0x80);
+                _spriteData.push_back(0);
+            }
+        }
+
+        _sprite.offset = _spriteData.data();
+        _sprite.width = SpriteWidth;
+        _sprite.height = SpriteHeight;
+        _sprite.flags = G1_FLAG_RLE_COMPRESSION;
+    }
+
+    std::vector<uint8_t> Draw(
+        ZoomLevel zoom, ImageId imageId, const PaletteMap& paletteMap, int32_t srcX, int32_t srcY, int32_t width,
+        int32_t height)
+    {
+        constexpr int32_t bufferWidth = 64;
+        constexpr int32_t bufferHeight = 64;
+        std::vector<uint8_t> buffer(bufferWidth * bufferHeight, 0x11);
+
+        DrawPixelInfo dpi;
+        dpi.bits = buffer.data();
+        dpi.width = zoom.ApplyTo(bufferWidth);
+        dpi.height = zoom.ApplyTo(bufferHeight);
+        dpi.zoom_level = zoom;
+
+        DrawSpriteArgs args(imageId, paletteMap, _sprite, srcX, srcY, width, height, buffer.data() + bufferWidth + 1);
+        GfxRleSpriteToBuffer(dpi, args);
+        return buffer;
+    }
+
+    void CheckCachedMatchesDirect(ImageId imageId, const PaletteMap& paletteMap)
+    {
+        for (int32_t zoom = 1; zoom <= 3; zoom++)
+        {
+            for (int32_t srcY = -1; srcY < 9; srcY++)
+            {
+                for (int32_t srcX = 0; srcX < 9; srcX++)
+                {
+                    const auto width = SpriteWidth - srcX - (srcY & 3);
+                    const auto height = SpriteHeight - std::max(srcY, 0) - (srcX & 3);
+
+                    gConfigGeneral.SpriteCacheSize = 0;
+                    const auto expected = Draw(
+                        ZoomLevel{ static_cast<int8_t>(zoom) }, imageId, paletteMap, srcX, srcY, width, height);
+
+                    // Once when the sprite is minified and once from the cache.
+                    gConfigGeneral.SpriteCacheSize = 32;
+                    for (int32_t i = 0; i < 2; i++)
+                    {
+                        const auto actual = Draw(
+                            ZoomLevel{ static_cast<int8_t>(zoom) }, imageId, paletteMap, srcX, srcY, width, height);
+                        ASSERT_EQ(actual, expected) << "zoom " << zoom << " src " << srcX << ", " << srcY;
+                    }
+                }
+            }
+        }
+    }
+};
+
+TEST_F(SpriteCacheTest, cached_matches_direct)
+{
+    CheckCachedMatchesDirect(ImageId(1234), PaletteMap::GetDefault());
+}
+
+TEST_F(SpriteCacheTest, cached_matches_direct_remapped)
+{
+    uint8_t table[256];
+    for (int32_t i = 0; i < 256; i++)
+    {
+        table[i] = static_cast<uint8_t>((i * 7) % 251);
+    }
+    CheckCachedMatchesDirect(ImageId(1234, COLOUR_BRIGHT_RED), PaletteMap(table));
+}
+
+TEST_F(SpriteCacheTest, hits_and_misses)
+{
+    SpriteCache cache(1024 * 1024);
+    ASSERT_NE(cache.Get(1, _sprite, 1, 0, 0), nullptr);
+    ASSERT_NE(cache.Get(1, _sprite, 1, 0, 0), nullptr);
+    ASSERT_NE(cache.Get(1, _sprite, 1, 1, 0), nullptr);
+    ASSERT_NE(cache.Get(1, _sprite, 2, 0, 0), nullptr);
+
+    auto stats = cache.GetStats();
+    ASSERT_EQ(stats.Hits, 1U);
+    ASSERT_EQ(stats.Misses, 3U);
+    ASSERT_EQ(stats.NumEntries, 3U);
+
+    // A replaced sprite is minified again.
+    auto otherData = _spriteData;
+    auto otherSprite = _sprite;
+    otherSprite.offset = otherData.data();
+    ASSERT_EQ(cache.Get(1, otherSprite, 1, 0, 0)->SourceData, otherData.data());
+    stats = cache.GetStats();
+    ASSERT_EQ(stats.Misses, 4U);
+    ASSERT_EQ(stats.NumEntries, 3U);
+
+    cache.ResetStats();
+    cache.Clear();
+    stats = cache.GetStats();
+    ASSERT_EQ(stats.Hits, 0U);
+    ASSERT_EQ(stats.NumEntries, 0U);
+    ASSERT_EQ(stats.MemoryUsage, 0U);
+}
+
+TEST_F(SpriteCacheTest, evicts_least_recently_used)
+{
+    const auto spriteSize = MinifyRLESprite(_sprite, 1, 0, 0)->GetMemoryUsage();
+    SpriteCache cache(spriteSize * 2 + spriteSize / 2);
+
+    cache.Get(1, _sprite, 1, 0, 0);
+    cache.Get(2, _sprite, 1, 0, 0);
+    cache.Get(1, _sprite, 1, 0, 0);
+    cache.Get(3, _sprite, 1, 0, 0);
+
+    auto stats = cache.GetStats();
+    ASSERT_EQ(stats.NumEntries, 2U);
+    ASSERT_EQ(stats.Evictions, 1U);
+    ASSERT_LE(stats.MemoryUsage, cache.GetBudget());
+
+    // Image 2 was the least recently used.
+    cache.ResetStats();
+    cache.Get(1, _sprite, 1, 0, 0);
+    cache.Get(3, _sprite, 1, 0, 0);
+    ASSERT_EQ(cache.GetStats().Hits, 2U);
+    cache.Get(2, _sprite, 1, 0, 0);
+    ASSERT_EQ(cache.GetStats().Misses, 1U);
+
+    cache.SetBudget(0);
+    ASSERT_EQ(cache.GetStats().NumEntries, 0U);
+    ASSERT_EQ(cache.Get(1, _sprite, 1, 0, 0), nullptr);
+}